@@ -1,4 +1,12 @@
 #pragma once
 
-#include <rowen/core/transport/packet_receiver.hpp>  // IWYU pragma: export
-#include <rowen/core/transport/packet_typedef.hpp>   // IWYU pragma: export
+#include <rowen/core/transport/crc32c.hpp>             // IWYU pragma: export
+#include <rowen/core/transport/lz_codec.hpp>           // IWYU pragma: export
+#include <rowen/core/transport/packet_builder.hpp>     // IWYU pragma: export
+#include <rowen/core/transport/packet_dispatcher.hpp>  // IWYU pragma: export
+#include <rowen/core/transport/packet_gather.hpp>      // IWYU pragma: export
+#include <rowen/core/transport/packet_message.hpp>     // IWYU pragma: export
+#include <rowen/core/transport/packet_receiver.hpp>    // IWYU pragma: export
+#include <rowen/core/transport/packet_scanner.hpp>     // IWYU pragma: export
+#include <rowen/core/transport/packet_typedef.hpp>     // IWYU pragma: export
+#include <rowen/core/transport/packet_view.hpp>        // IWYU pragma: export
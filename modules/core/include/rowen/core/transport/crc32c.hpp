@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace rs {
+
+/**
+ * @brief CRC32C (Castagnoli, reflected polynomial 0x82F63B78)
+ * @details SSE4.2 (x86_64) 또는 CRC 확장 (arm64)을 지원하는 CPU에서는 하드웨어 명령을 사용하고,
+ *          지원하지 않는 경우 slicing-by-8 테이블을 사용한다. (구현은 최초 호출 시 한 번 결정된다)
+ * @param data : data buffer
+ * @param size : data size (byte)
+ * @param crc : previous crc value (for incremental calculation)
+ */
+uint32_t crc32c(const void* data, size_t size, uint32_t crc = 0);
+
+/**
+ * @brief Selected CRC32C implementation name ("sse4.2", "armv8-crc", "slicing-by-8")
+ */
+const char* crc32c_implementation();
+
+};  // namespace rs
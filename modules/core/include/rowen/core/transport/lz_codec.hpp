@@ -0,0 +1,34 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace rs {
+
+/**
+ * @brief Maximum compressed size of `size` bytes (incompressible data)
+ */
+constexpr size_t lz_compress_bound(const size_t size) { return size + size / 255 + 16; }
+
+/**
+ * @brief Compress data (LZ4 block format compatible, no external dependency)
+ * @details 외부 LZ4 라이브러리의 LZ4_decompress_safe()로도 해제할 수 있다.
+ * @param source : data buffer
+ * @param size : data size (byte)
+ * @param destination : compressed data buffer
+ * @param capacity : compressed data buffer size (lz_compress_bound(size) 이상이면 항상 성공한다)
+ * @return compressed size (0 if failed or capacity is not enough)
+ */
+size_t lz_compress(const uint8_t* source, const size_t size, uint8_t* destination, const size_t capacity);
+
+/**
+ * @brief Decompress data which is compressed by lz_compress()
+ * @details 입력이 손상된 경우에도 buffer 범위를 벗어나지 않는다.
+ * @param capacity : decompressed data buffer size (원본 크기)
+ * @return decompressed size (-1 if data is malformed or capacity is not enough)
+ */
+ssize_t lz_decompress(const uint8_t* source, const size_t size, uint8_t* destination, const size_t capacity);
+
+};  // namespace rs
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <rowen/core/transport/packet_typedef.hpp>
+#include <rowen/core/transport/packet_view.hpp>
+#include <string>
+#include <vector>
+
+namespace rs {
+
+/**
+ * @brief Build rs::Packet in place (without allocation per packet)
+ * @details 사용자 버퍼 또는 thread-local 버퍼 pool에 header, payload, trailer를 직접 작성한다.
+ *          pool 버퍼는 builder가 소멸될 때 pool로 반환되며, 한번 커진 버퍼는 재사용되므로
+ *          같은 크기의 패킷을 반복 생성하는 경우 할당이 발생하지 않는다.
+ */
+class PacketBuilder
+{
+ public:
+  /**
+   * @brief Build with thread-local buffer pool
+   */
+  PacketBuilder();
+
+  /**
+   * @brief Build with user buffer (span)
+   * @param buffer : destination buffer (builder보다 오래 유지되어야 한다)
+   * @param capacity : destination buffer size (byte)
+   */
+  PacketBuilder(uint8_t* buffer, const size_t capacity);
+
+  PacketBuilder(const PacketBuilder&)            = delete;
+  PacketBuilder& operator=(const PacketBuilder&) = delete;
+  ~PacketBuilder();
+
+ public:
+  /**
+   * @brief Make Packet
+   */
+  bool make(const uint16_t version, const uint8_t source, const uint8_t destination, const uint32_t opcode,
+            const uint8_t* payload, const size_t payload_size);
+
+  /**
+   * @brief Make Packet from opcode and payload
+   */
+  bool make(const int opcode, const uint8_t* payload, const size_t payload_size);
+
+  bool make(const int opcode, const std::string& json_data);
+
+  /**
+   * @brief Make Packet with compressed payload (FLAG_COMPRESSED)
+   * @details 압축 후 크기가 줄어들지 않으면 압축하지 않은 패킷을 만든다
+   */
+  bool makeCompressed(const uint16_t version, const uint8_t source, const uint8_t destination, const uint32_t opcode,
+                      const uint8_t* payload, const size_t payload_size);
+
+  bool makeCompressed(const int opcode, const uint8_t* payload, const size_t payload_size);
+
+  bool makeCompressed(const int opcode, const std::string& json_data);
+
+  /**
+   * @brief Reserve payload area to write payload directly
+   * @details 반환된 영역에 payload를 작성한 후 commit()을 호출한다
+   * @return payload buffer (nullptr if capacity is not enough)
+   */
+  uint8_t* prepare(const uint32_t opcode, const size_t payload_size);
+
+  /**
+   * @brief Complete packet which is prepared by prepare()
+   */
+  bool commit(const uint16_t version = 0, const uint8_t source = 0, const uint8_t destination = 0);
+
+  /**
+   * @brief Clear built packet (buffer is kept)
+   */
+  void reset();
+
+ public:
+  // Update
+  void updateTimestamp(uint64_t microsec = Packet::current_time()) const;
+
+  // Buffer
+  const uint8_t*         data() const { return size_ > 0 ? buffer_ : nullptr; }
+  ssize_t                size() const { return size_; }
+  PacketSpan             span() const { return { data(), size_ }; }
+  const Packet::Header*  header() const { return size_ > 0 ? reinterpret_cast<const Packet::Header*>(buffer_) : nullptr; }
+  const uint8_t*         payload() const { return size_ > 0 ? buffer_ + Packet::HEADER_SIZE : nullptr; }
+  const Packet::Trailer* trailer() const { return size_ > 0 ? reinterpret_cast<const Packet::Trailer*>(buffer_ + size_ - Packet::TRAILER_SIZE) : nullptr; }
+  size_t                 capacity() const { return capacity_; }
+
+ private:
+  bool reserve(const size_t packet_size);
+
+ private:
+  std::vector<uint8_t>* pooled_   = nullptr;  // thread-local pool buffer (nullptr if user buffer)
+  uint8_t*              buffer_   = nullptr;
+  size_t                capacity_ = 0;
+  size_t                size_     = 0;
+
+  // prepare()로 예약된 payload
+  uint32_t prepared_opcode_       = 0;
+  size_t   prepared_payload_size_ = 0;
+};
+
+};  // namespace rs
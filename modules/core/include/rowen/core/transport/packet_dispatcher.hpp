@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <rowen/core/transport/packet_typedef.hpp>
+#include <rowen/core/transport/packet_view.hpp>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rs {
+
+/**
+ * @brief Per-opcode handler table for received rs::Packet
+ * @details opcode < DIRECT_OPCODE_SIZE 는 배열 index로, 그 외의 opcode는 정렬된 vector의 binary search로 찾는다.
+ *          handler는 함수 포인터 + context로 호출된다 (std::function 미사용).
+ *          dispatch는 한 thread에서 호출해야 하며, handler 등록(on, off)은 dispatch와 동시에 호출하면 안된다.
+ *          counter는 다른 thread에서 읽을 수 있다.
+ */
+class PacketDispatcher
+{
+ public:
+  using Function = void (*)(void* context, const Packet::Header& header, const PacketSpan& payload);
+
+  static constexpr uint32_t DIRECT_OPCODE_SIZE = 256;
+
+  struct Statistics
+  {
+    uint32_t opcode         = 0;
+    uint64_t count          = 0;  // dispatched packets
+    uint64_t bytes          = 0;  // dispatched bytes (packet size)
+    uint64_t last_timestamp = 0;  // header timestamp of last packet (microsec)
+  };
+
+ public:
+  PacketDispatcher();
+  PacketDispatcher(const PacketDispatcher&)            = delete;
+  PacketDispatcher& operator=(const PacketDispatcher&) = delete;
+  ~PacketDispatcher()                                  = default;
+
+ public:
+  /**
+   * @brief Attach handler function (function(context, header, payload))
+   */
+  void on(const uint32_t opcode, Function function, void* context = nullptr);
+
+  /**
+   * @brief Attach member function (object->Method(header, payload))
+   * @details object는 dispatcher보다 오래 유지되어야 한다
+   */
+  template <auto Method, typename Object>
+  void on(const uint32_t opcode, Object* object)
+  {
+    on(opcode, [](void* context, const Packet::Header& header, const PacketSpan& payload) { (static_cast<Object*>(context)->*Method)(header, payload); }, object);
+  }
+
+  /**
+   * @brief Attach callable (lambda etc.) which is stored in dispatcher (callable(header, payload))
+   */
+  template <typename Callable, typename = std::enable_if_t<!std::is_convertible<Callable, Function>::value>>
+  void on(const uint32_t opcode, Callable&& callable)
+  {
+    using Type = std::decay_t<Callable>;
+
+    auto storage = std::make_shared<Type>(std::forward<Callable>(callable));
+    auto context = storage.get();
+
+    on(opcode, [](void* context, const Packet::Header& header, const PacketSpan& payload) { (*static_cast<Type*>(context))(header, payload); }, context);
+
+    slot(opcode, true)->storage = std::move(storage);
+  }
+
+  /**
+   * @brief Detach handler (counter is kept)
+   */
+  void off(const uint32_t opcode);
+
+  /**
+   * @brief Dispatch packet to handler of opcode
+   * @param packet : packet buffer (header + payload + trailer)
+   * @return false if handler is not attached
+   */
+  bool dispatch(const uint8_t* packet, const size_t size);
+
+  bool dispatch(const PacketSpan& packet) { return dispatch(packet.data, packet.size); }
+  bool dispatch(const PacketView& packet) { return dispatch(packet.data(), packet.size()); }
+  bool dispatch(const Packet& packet) { return dispatch(packet.data(), packet.size()); }
+
+  bool contains(const uint32_t opcode) const;
+
+ public:
+  /**
+   * @brief Snapshot of per-opcode counters (handler가 등록되었거나 수신된 적이 있는 opcode, opcode 오름차순)
+   */
+  std::vector<Statistics> statistics() const;
+
+  /**
+   * @brief Number of packets which has no handler
+   */
+  uint64_t unhandled() const { return unhandled_.load(std::memory_order_relaxed); }
+
+  void resetStatistics();
+
+ private:
+  struct Slot
+  {
+    Function              function = nullptr;
+    void*                 context  = nullptr;
+    std::shared_ptr<void> storage  = nullptr;  // owned callable
+
+    std::atomic<uint64_t> count          = { 0 };
+    std::atomic<uint64_t> bytes          = { 0 };
+    std::atomic<uint64_t> last_timestamp = { 0 };
+  };
+
+  using SparseSlot = std::pair<uint32_t, std::unique_ptr<Slot>>;
+
+  Slot*       slot(const uint32_t opcode, bool create);
+  const Slot* slot(const uint32_t opcode) const;
+
+  static Statistics snapshot(const uint32_t opcode, const Slot& slot);
+
+ private:
+  std::unique_ptr<Slot[]> direct_slot_ = nullptr;  // opcode < DIRECT_OPCODE_SIZE
+  std::vector<SparseSlot> sparse_slot_ = {};       // opcode 오름차순
+
+  std::atomic<uint64_t> unhandled_ = { 0 };
+};
+
+};  // namespace rs
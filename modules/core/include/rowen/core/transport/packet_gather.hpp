@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <rowen/core/transport/packet_typedef.hpp>
+#include <rowen/core/transport/packet_view.hpp>
+
+namespace rs {
+
+/**
+ * @brief rs::Packet for scatter-gather send (header, payload, trailer)
+ * @details header와 trailer는 내부 버퍼에 두고, payload는 사용자 메모리를 그대로 가리킨다 (복사 없음).
+ *          payload 메모리는 전송이 끝날 때까지 유지되어야 한다.
+ *          socket의 sendmsg/writev로 세 영역을 한 번에 전송한다.
+ */
+class PacketGather
+{
+ public:
+  using Segments = std::array<PacketSpan, 3>;  // header, payload, trailer
+
+ public:
+  PacketGather() = default;
+
+  /**
+   * @brief Make gather packet from opcode and payload
+   */
+  PacketGather(const int opcode, const uint8_t* payload, const size_t payload_size);
+
+  /**
+   * @brief Make gather packet
+   * @param with_checksum : payload의 CRC32C를 계산한다 (false면 0. 수신측이 검사하는 경우 버려진다)
+   */
+  bool make(const uint16_t version, const uint8_t source, const uint8_t destination, const uint32_t opcode,
+            const uint8_t* payload, const size_t payload_size, const bool with_checksum = true);
+
+  bool make(const int opcode, const uint8_t* payload, const size_t payload_size);
+
+  /**
+   * @brief Check gather packet is made
+   */
+  bool valid() const { return payload_ != nullptr; }
+
+ public:
+  // Update
+  void updateTimestamp(uint64_t microsec = Packet::current_time()) const;
+  void updateRequestId(uint32_t request_id) const;
+
+  // Buffer
+  const Packet::Header*  header() const { return valid() ? reinterpret_cast<const Packet::Header*>(header_) : nullptr; }
+  const uint8_t*         payload() const { return payload_; }
+  const Packet::Trailer* trailer() const { return valid() ? reinterpret_cast<const Packet::Trailer*>(trailer_) : nullptr; }
+  Segments               segments() const;
+
+  // Size
+  ssize_t size() const { return valid() ? Packet::PACKET_SIZE(payload_size_) : 0; }
+  ssize_t payload_size() const { return payload_size_; }
+
+ private:
+  mutable uint8_t header_[Packet::HEADER_SIZE]   = {};
+  uint8_t         trailer_[Packet::TRAILER_SIZE] = {};
+  const uint8_t*  payload_                       = nullptr;
+  size_t          payload_size_                  = 0;
+};
+
+};  // namespace rs
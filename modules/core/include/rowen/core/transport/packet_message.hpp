@@ -0,0 +1,293 @@
+#pragma once
+
+#include <array>
+#include <cstring>
+#include <functional>
+#include <rowen/core/transport/packet_builder.hpp>
+#include <rowen/core/transport/packet_typedef.hpp>
+#include <rowen/core/transport/packet_view.hpp>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace rs {
+
+/**
+ * @brief Typed message schema (opcode <-> POD payload)
+ * @details payload는 구조체를 그대로 복사한다 (JSON 변환 없음). 송수신 양측의 구조체 정의와 byte order가 같아야 한다.
+ * @tparam Opcode : packet opcode
+ * @tparam PodStruct : trivially copyable payload structure
+ */
+template <uint32_t Opcode, typename PodStruct>
+struct message
+{
+  static_assert(Opcode != 0, "rs::message opcode must not be 0 (undefined opcode)");
+  static_assert(std::is_trivially_copyable<PodStruct>::value, "rs::message payload must be trivially copyable");
+  static_assert(std::is_standard_layout<PodStruct>::value, "rs::message payload must be standard layout");
+  static_assert(sizeof(PodStruct) <= static_cast<size_t>(INT32_MAX) - Packet::HEADER_SIZE - Packet::TRAILER_SIZE,
+                "rs::message payload is too large");
+
+  using type = PodStruct;
+
+  static constexpr uint32_t opcode       = Opcode;
+  static constexpr size_t   payload_size = sizeof(PodStruct);
+  static constexpr size_t   packet_size  = Packet::PACKET_SIZE(sizeof(PodStruct));
+
+  /**
+   * @brief Build packet of message
+   */
+  static bool encode(PacketBuilder& builder, const PodStruct& value)
+  {
+    auto payload = builder.prepare(opcode, payload_size);
+    if (payload == nullptr)
+      return false;
+
+    std::memcpy(payload, &value, payload_size);
+    return builder.commit();
+  }
+
+  /**
+   * @brief Read payload of message (opcode, payload size are checked)
+   * @param packet : packet buffer (header + payload + trailer)
+   */
+  static bool decode(const uint8_t* packet, const size_t size, PodStruct& value)
+  {
+    if (packet == nullptr || size < packet_size)
+      return false;
+
+    auto header = reinterpret_cast<const Packet::Header*>(packet);
+    if (header->data.opcode != opcode || header->data.payload_size != payload_size)
+      return false;
+
+    // 수신 버퍼는 정렬되어 있지 않으므로 복사한다
+    std::memcpy(&value, packet + Packet::HEADER_SIZE, payload_size);
+    return true;
+  }
+};
+
+/**
+ * @brief Compile-time registry of rs::message
+ * @details opcode 중복, 구조체 중복은 컴파일 시 검사된다.
+ *          수신 패킷은 컴파일 시 정렬된 opcode 테이블에서 찾은 함수 포인터(jump table)로 처리한다.
+ *
+ *   using Registry = rs::message_registry<rs::message<1, Telemetry>, rs::message<2, Command>>;
+ *   Registry registry;
+ *   registry.on<Telemetry>([](const Telemetry& telemetry) { ... });
+ *   registry.dispatch(packet_view);
+ *   Registry::send(connector, Command{ ... });
+ */
+template <typename... Messages>
+class message_registry
+{
+  static_assert(sizeof...(Messages) > 0, "rs::message_registry requires at least one message");
+
+  static constexpr size_t COUNT = sizeof...(Messages);
+
+  using Opcodes = std::array<uint32_t, COUNT>;
+
+  struct Entry
+  {
+    uint32_t opcode;
+    size_t   index;
+  };
+
+  static constexpr Opcodes OPCODES = { Messages::opcode... };
+
+  static constexpr bool unique_opcode()
+  {
+    for (size_t i = 0; i < COUNT; ++i)
+      for (size_t j = i + 1; j < COUNT; ++j)
+        if (OPCODES[i] == OPCODES[j])
+          return false;
+    return true;
+  }
+
+  template <typename T>
+  static constexpr size_t type_count()
+  {
+    return (0 + ... + (std::is_same<T, typename Messages::type>::value ? 1 : 0));
+  }
+
+  static_assert(unique_opcode(), "rs::message_registry has duplicated opcode");
+  static_assert(((type_count<typename Messages::type>() == 1) && ...), "rs::message_registry has duplicated payload type");
+
+  // opcode 오름차순 (binary search)
+  static constexpr std::array<Entry, COUNT> sorted_entries()
+  {
+    std::array<Entry, COUNT> entries = {};
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+      size_t position = i;
+      while (position > 0 && entries[position - 1].opcode > OPCODES[i])
+      {
+        entries[position] = entries[position - 1];
+        position--;
+      }
+      entries[position] = Entry{ OPCODES[i], i };
+    }
+    return entries;
+  }
+
+  static constexpr std::array<Entry, COUNT> ENTRIES = sorted_entries();
+
+  template <typename T>
+  static constexpr size_t index_of()
+  {
+    static_assert(type_count<T>() == 1, "payload type is not registered in rs::message_registry");
+
+    size_t index = 0;
+    ((std::is_same<T, typename Messages::type>::value ? false : (++index, true)) && ...);
+    return index;
+  }
+
+ public:
+  template <typename T>
+  using message_of = std::tuple_element_t<index_of<T>(), std::tuple<Messages...>>;
+
+  template <typename T>
+  using Handler = std::function<void(const T&)>;
+
+ public:
+  template <typename T>
+  static constexpr uint32_t opcode_of() { return message_of<T>::opcode; }
+
+  /**
+   * @brief Find registered message index of opcode (compile time table)
+   * @return index (COUNT if not registered)
+   */
+  static constexpr size_t find(const uint32_t opcode)
+  {
+    size_t first = 0;
+    size_t last  = COUNT;
+    while (first < last)
+    {
+      size_t middle = (first + last) / 2;
+      if (ENTRIES[middle].opcode < opcode)
+        first = middle + 1;
+      else
+        last = middle;
+    }
+    return (first < COUNT && ENTRIES[first].opcode == opcode) ? ENTRIES[first].index : COUNT;
+  }
+
+  static constexpr bool contains(const uint32_t opcode) { return find(opcode) != COUNT; }
+
+  /**
+   * @brief Build packet of typed message
+   */
+  template <typename T>
+  static bool encode(PacketBuilder& builder, const T& value)
+  {
+    return message_of<T>::encode(builder, value);
+  }
+
+  /**
+   * @brief Send typed message to connector (send(data, size) or sendto(data, size))
+   * @details 패킷은 스택 버퍼에 작성되므로 할당이 발생하지 않는다
+   */
+  template <typename T, typename Transport>
+  static ssize_t send(Transport& transport, const T& value)
+  {
+    uint8_t           buffer[message_of<T>::packet_size];
+    rs::PacketBuilder builder(buffer, sizeof(buffer));
+
+    if (!encode(builder, value))
+      return -1;
+
+    if constexpr (has_send<Transport>(0))
+      return transport.send(builder.data(), builder.size());
+    else
+      return transport.sendto(builder.data(), builder.size());
+  }
+
+  /**
+   * @brief Send typed message to target of listener (send(target, data, size))
+   */
+  template <typename T, typename Transport, typename Target>
+  static ssize_t send(Transport& transport, const Target& target, const T& value)
+  {
+    uint8_t           buffer[message_of<T>::packet_size];
+    rs::PacketBuilder builder(buffer, sizeof(buffer));
+
+    if (!encode(builder, value))
+      return -1;
+
+    return transport.send(target, builder.data(), builder.size());
+  }
+
+ public:
+  /**
+   * @brief Attach typed handler
+   */
+  template <typename T>
+  void on(Handler<T> handler)
+  {
+    std::get<index_of<T>()>(handlers_) = std::move(handler);
+  }
+
+  template <typename T>
+  void off()
+  {
+    std::get<index_of<T>()>(handlers_) = nullptr;
+  }
+
+  /**
+   * @brief Dispatch received packet to typed handler
+   * @param packet : packet buffer (header + payload + trailer)
+   * @return false if opcode is not registered, payload size is mismatched or handler is not attached
+   */
+  bool dispatch(const uint8_t* packet, const size_t size) const
+  {
+    if (packet == nullptr || size < static_cast<size_t>(Packet::HEADER_SIZE))
+      return false;
+
+    auto index = find(reinterpret_cast<const Packet::Header*>(packet)->data.opcode);
+    if (index == COUNT)
+      return false;
+
+    return JUMP_TABLE[index](*this, packet, size);
+  }
+
+  bool dispatch(const PacketSpan& packet) const { return dispatch(packet.data, packet.size); }
+  bool dispatch(const PacketView& packet) const { return dispatch(packet.data(), packet.size()); }
+  bool dispatch(const Packet& packet) const { return dispatch(packet.data(), packet.size()); }
+
+ private:
+  using Invoker = bool (*)(const message_registry&, const uint8_t*, const size_t);
+
+  template <size_t Index>
+  static bool invoke(const message_registry& registry, const uint8_t* packet, const size_t size)
+  {
+    using Message = std::tuple_element_t<Index, std::tuple<Messages...>>;
+
+    auto& handler = std::get<Index>(registry.handlers_);
+    if (!handler)
+      return false;
+
+    typename Message::type value;
+    if (!Message::decode(packet, size, value))
+      return false;
+
+    handler(value);
+    return true;
+  }
+
+  template <size_t... Index>
+  static constexpr std::array<Invoker, COUNT> make_jump_table(std::index_sequence<Index...>)
+  {
+    return { &invoke<Index>... };
+  }
+
+  static constexpr std::array<Invoker, COUNT> JUMP_TABLE = make_jump_table(std::make_index_sequence<COUNT>());
+
+  template <typename Transport>
+  static constexpr auto has_send(int) -> decltype(std::declval<Transport&>().send(std::declval<const uint8_t*>(), size_t()), bool()) { return true; }
+
+  template <typename Transport>
+  static constexpr bool has_send(...) { return false; }
+
+ private:
+  std::tuple<Handler<typename Messages::type>...> handlers_ = {};
+};
+
+};  // namespace rs
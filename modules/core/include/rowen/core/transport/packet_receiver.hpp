@@ -4,17 +4,28 @@
 
 #include <functional>
 #include <mutex>
+#include <rowen/core/transport/packet_dispatcher.hpp>
 #include <rowen/core/transport/packet_typedef.hpp>
+#include <rowen/core/transport/packet_view.hpp>
 #include <vector>
 
 namespace rs {
 
+/**
+ * @brief Reassemble rs::Packet from received byte stream
+ * @details 압축된 패킷(FLAG_COMPRESSED)은 pool의 slab에 압축을 해제하여 전달한다
+ */
 class PacketReceiver
 {
   using OnReceivedCallback = std::function<void(const uint8_t*, const ssize_t)>;
 
  public:
-  using Result = std::vector<std::vector<uint8_t>>;
+  // 수신 버퍼(slab)를 공유하는 패킷 (복사 없음. view가 모두 해제되면 slab은 pool로 반환된다)
+  using Result = std::vector<PacketView>;
+
+  // 내부 수신 버퍼 내의 패킷 영역 (다음 store(), store_and_drain(), clear() 호출 전까지 유효)
+  using Span  = PacketSpan;
+  using Spans = std::vector<Span>;
 
  public:
   PacketReceiver()                                 = default;
@@ -25,6 +36,14 @@ class PacketReceiver
  public:
   void store(const uint8_t* buffer, const ssize_t size);
 
+  /**
+   * @brief Store received data and drain every completed packet at once
+   * @details 패킷을 복사하지 않고 내부 버퍼를 가리키는 Span으로 반환한다 (callback, grab 버퍼는 사용하지 않음)
+   *          반환된 Span은 다음 store(), store_and_drain(), clear() 호출 전까지 유효하다
+   * @return number of drained packets
+   */
+  size_t store_and_drain(const uint8_t* buffer, const ssize_t size, Spans& packets);
+
   Result grab();
 
   size_t grab(Result& result);
@@ -35,19 +54,46 @@ class PacketReceiver
 
   void resetCallback();
 
-  decltype(auto) cache_size() const { return cache_receive_buffer_.size(); }
+  /**
+   * @brief Deliver received packet to per-opcode handler of dispatcher (callback, grab 버퍼보다 우선한다)
+   * @details dispatcher는 receiver보다 오래 유지되어야 한다
+   */
+  void attachDispatcher(PacketDispatcher* dispatcher);
+
+  void resetDispatcher();
+
+  /**
+   * @brief Verify payload checksum (CRC32C) of received packet (default : false)
+   * @details checksum이 일치하지 않는 패킷은 전달하지 않고 버린다
+   */
+  void setVerifyChecksum(bool verify);
+
+  decltype(auto) cache_size() const { return cache_receive_buffer_->size() - cache_read_offset_; }
   decltype(auto) buffer_size() const { return received_packet_buffer_.size(); }
   decltype(auto) using_callback() const { return received_packet_callback_ != nullptr; }
+  decltype(auto) using_dispatcher() const { return received_packet_dispatcher_ != nullptr; }
+  decltype(auto) verify_checksum() const { return verify_checksum_; }
 
  private:
-  void progress();
+  void progress(Spans* drained = nullptr);
+
+  void append(const uint8_t* buffer, const size_t size);
+
+  void compact();
+
+  PacketSlabPool::SlabPtr decompress(const uint8_t* packet);
 
- public:
  private:
-  // Receive
-  std::vector<uint8_t> cache_receive_buffer_ = {};
-  rs::Packet::Header*  progress_header_      = nullptr;
-  std::mutex           progress_mutex_;
+  // Receive (cache_read_offset_ 이전의 데이터는 이미 처리된 영역)
+  std::shared_ptr<PacketSlabPool> slab_pool_            = PacketSlabPool::create();
+  PacketSlabPool::SlabPtr         cache_receive_buffer_ = slab_pool_->acquire();
+  size_t                          cache_read_offset_    = 0;
+  bool                            progress_header_      = false;  // 읽기 위치에 유효한 Header가 있음
+  bool                            verify_checksum_      = false;
+  std::mutex                      progress_mutex_;
+
+  // 압축 해제된 패킷 (store_and_drain의 Span이 유효한 동안 유지)
+  std::vector<PacketSlabPool::SlabPtr> decompressed_slab_ = {};
 
   // by. store
   std::mutex received_packet_locker_ = {};
@@ -56,6 +102,9 @@ class PacketReceiver
   // by. callback
   std::mutex         received_packet_callback_locker_ = {};
   OnReceivedCallback received_packet_callback_        = nullptr;
+
+  // by. dispatcher
+  PacketDispatcher* received_packet_dispatcher_ = nullptr;
 };
 
 };  // namespace rs
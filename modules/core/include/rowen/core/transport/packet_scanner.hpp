@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace rs {
+
+/**
+ * @brief Find rs::Packet header candidate in byte stream (resynchronization)
+ * @details SOH, STX 위치와 total_size 필드를 함께 검사한다. SIMD (AVX2, SSE2, NEON)로 여러 바이트를 한 번에 검사하며,
+ *          구현은 최초 호출 시 한 번 결정된다.
+ * @param first : begin of stream
+ * @param last : end of stream
+ * @return valid header position.
+ *         찾지 못한 경우 header를 검사하기에 데이터가 부족한 첫 SOH 위치, 그것도 없으면 last
+ */
+const uint8_t* find_packet_header(const uint8_t* first, const uint8_t* last);
+
+/**
+ * @brief Selected header scanner implementation name ("avx2", "sse2", "neon", "scalar")
+ */
+const char* packet_scanner_implementation();
+
+};  // namespace rs
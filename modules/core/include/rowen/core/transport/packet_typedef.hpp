@@ -3,6 +3,7 @@
 #include <chrono>
 #include <cstdint>
 #include <cstring>
+#include <rowen/core/transport/lz_codec.hpp>
 #include <string>
 #include <vector>
 
@@ -19,17 +20,25 @@ namespace rs {
 
 class Packet
 {
+  friend class PacketBuilder;
+  friend class PacketGather;
+
   static constexpr uint16_t UNDEFINED_VERSION   = 0x00;
   static constexpr uint8_t  UNDEFINED_TRANSPORT = 0X00;
   static constexpr uint64_t UNDEFINED_TIMESTAMP = 0x0000000000000000;
   static constexpr uint32_t UNDEFINED_OPCODE    = 0;
   static constexpr uint32_t UNDEFINED_SIZE      = 0;
+  static constexpr uint32_t UNDEFINED_REQUEST   = 0;
 
  public:
   static constexpr uint8_t SOH = 0x01;
   static constexpr uint8_t STX = 0x02;
   static constexpr uint8_t ETX = 0x03;
 
+  // Header::Data::flags
+  static constexpr uint8_t FLAG_NONE       = 0x00;
+  static constexpr uint8_t FLAG_COMPRESSED = 0x01;  // payload = 원본 크기 (uint32_t) + LZ 압축 데이터 (rs::lz_compress)
+
  public:
   struct PACKED Header
   {
@@ -44,7 +53,9 @@ class Packet
       uint32_t opcode       = UNDEFINED_OPCODE;     // 패킷의 종류 (오퍼레이션 코드)
       uint32_t total_size   = UNDEFINED_SIZE;       // 전체 패킷의 크기
       uint32_t payload_size = UNDEFINED_SIZE;       // 페이로드의 크기
-      uint8_t  reserved[16] = {};                   // 예약 영역
+      uint8_t  flags        = FLAG_NONE;            // 페이로드의 속성 (FLAG_*)
+      uint32_t request_id   = UNDEFINED_REQUEST;    // 요청 ID (응답은 요청의 ID를 그대로 사용한다. pipelining)
+      uint8_t  reserved[11] = {};                   // 예약 영역
     } data;
 
     const uint8_t STX_ = STX;
@@ -61,7 +72,7 @@ class Packet
   {
     struct PACKED Data
     {
-      uint32_t crc32        = 0x00000000;  // CRC32
+      uint32_t crc32        = 0x00000000;  // CRC32C (payload)
       uint8_t  reserved[16] = {};
     } data;
 
@@ -71,13 +82,22 @@ class Packet
  public:
   static constexpr int     HEADER_SIZE  = sizeof(Header);
   static constexpr int     TRAILER_SIZE = sizeof(Trailer);
-  static constexpr ssize_t PACKET_SIZE(const int payload_size) { return HEADER_SIZE + payload_size + TRAILER_SIZE; }
+
+  // 수신 측에서 header로 인정하는 최대 payload 크기 (잘못된 header가 큰 total_size로 수신 버퍼를 붙잡지 않도록)
+  static constexpr size_t MAX_PAYLOAD_SIZE = size_t(1) << 30;
+
+  static constexpr ssize_t PACKET_SIZE(const size_t payload_size) { return HEADER_SIZE + payload_size + TRAILER_SIZE; }
   static constexpr ssize_t PACKET_SIZE(const Header& packet_header) { return PACKET_SIZE(packet_header.data.payload_size); }
 
+  // 압축 패킷의 최대 크기 (압축되지 않는 데이터)
+  static constexpr size_t COMPRESSED_PACKET_BOUND(const size_t payload_size) { return HEADER_SIZE + sizeof(uint32_t) + lz_compress_bound(payload_size) + TRAILER_SIZE; }
+
  public:
   Packet()                               = default;
   Packet(const Packet& other)            = delete;
   Packet& operator=(const Packet& other) = delete;
+  Packet(Packet&& other) noexcept;
+  Packet& operator=(Packet&& other) noexcept;
   virtual ~Packet();
 
   /**
@@ -108,6 +128,17 @@ class Packet
 
   bool make(const int opcode, const std::string& json_data);
 
+  /**
+   * @brief Make Packet with compressed payload (FLAG_COMPRESSED)
+   * @details 압축 후 크기가 줄어들지 않으면 압축하지 않은 패킷을 만든다
+   */
+  bool makeCompressed(const uint16_t version, const uint8_t source, const uint8_t destination, const uint32_t opcode,
+                      const uint8_t* payload, const size_t payload_size);
+
+  bool makeCompressed(const int opcode, const uint8_t* payload, const size_t payload_size);
+
+  bool makeCompressed(const int opcode, const std::string& json_data);
+
   /**
    * @brief Make Packet from other packet data
    */
@@ -118,16 +149,65 @@ class Packet
    */
   bool fill(const std::vector<uint8_t>& packet_byte_stream);
 
+  /**
+   * @brief Write Packet (header + payload + trailer) into buffer without allocation
+   * @param buffer : destination buffer
+   * @param capacity : destination buffer size (byte)
+   * @return packet size (0 if failed or capacity is not enough)
+   */
+  static size_t serialize(uint8_t* buffer, const size_t capacity,
+                          const uint16_t version, const uint8_t source, const uint8_t destination, const uint32_t opcode,
+                          const uint8_t* payload, const size_t payload_size);
+
+  /**
+   * @brief Write compressed Packet into buffer without allocation (압축 효과가 없으면 압축하지 않은 패킷을 작성한다)
+   * @param capacity : destination buffer size (COMPRESSED_PACKET_BOUND(payload_size) 이상)
+   * @return packet size (0 if failed or capacity is not enough)
+   */
+  static size_t serializeCompressed(uint8_t* buffer, const size_t capacity,
+                                    const uint16_t version, const uint8_t source, const uint8_t destination, const uint32_t opcode,
+                                    const uint8_t* payload, const size_t payload_size);
+
+  /**
+   * @brief Decompress payload of compressed packet (header, trailer는 압축되지 않은 패킷 기준으로 다시 작성된다)
+   * @param packet : compressed packet (header + payload + trailer)
+   * @param buffer : destination buffer (PACKET_SIZE(decompressedSize(packet)) 이상)
+   * @return packet size (0 if failed)
+   */
+  static size_t decompress(const uint8_t* packet, uint8_t* buffer, const size_t capacity);
+
+  /**
+   * @brief Original payload size of compressed packet (0 if not compressed or malformed)
+   */
+  static size_t decompressedSize(const uint8_t* packet);
+
+  /**
+   * @brief Write Header / Trailer only (payload is located elsewhere. ex. scatter-gather send)
+   * @param buffer : destination buffer (HEADER_SIZE or TRAILER_SIZE bytes)
+   */
+  static void serializeHeader(uint8_t* buffer,
+                              const uint16_t version, const uint8_t source, const uint8_t destination, const uint32_t opcode,
+                              const size_t payload_size, const uint8_t flags = FLAG_NONE);
+  static void serializeTrailer(uint8_t* buffer, const uint32_t crc32);
+
   /**
    * @brief Check Packet validation
+   * @param verify_checksum : trailer의 CRC32C와 payload를 비교한다 (default : false, PacketReceiver와 같다. checksum이 0인 이전 패킷도 허용)
    */
-  bool validation() const;
+  bool validation(bool verify_checksum = false) const;
+
+  /**
+   * @brief Calculate payload checksum (CRC32C)
+   */
+  static uint32_t checksum(const uint8_t* payload, const size_t payload_size);
 
  private:
   static constexpr size_t OFFSET_VERSION     = sizeof(SOH);
   static constexpr size_t OFFSET_SOURCE      = OFFSET_VERSION + sizeof(Header::Data::version);
   static constexpr size_t OFFSET_DESTINATION = OFFSET_SOURCE + sizeof(Header::Data::source);
   static constexpr size_t OFFSET_TIMESTAMP   = OFFSET_DESTINATION + sizeof(Header::Data::destination);
+  static constexpr size_t OFFSET_REQUEST_ID  = OFFSET_TIMESTAMP + sizeof(Header::Data::timestamp) + sizeof(Header::Data::opcode) +
+                                              sizeof(Header::Data::total_size) + sizeof(Header::Data::payload_size) + sizeof(Header::Data::flags);
 
  public:
   // Update
@@ -135,6 +215,7 @@ class Packet
   void updateSource(uint8_t source) const;
   void updateDestination(uint8_t destination) const;
   void updateTimestamp(uint64_t microsec = current_time()) const;
+  void updateRequestId(uint32_t request_id) const;
 
   // Buffer
   const uint8_t* data() const { return buffer_; }
@@ -147,6 +228,10 @@ class Packet
   ssize_t header_size() const { return HEADER_SIZE; }
   ssize_t payload_size() const { return header() ? header()->data.payload_size : UNDEFINED_SIZE; }
   ssize_t trailer_size() const { return TRAILER_SIZE; }
+  bool    compressed() const { return header() ? (header()->data.flags & FLAG_COMPRESSED) != 0 : false; }
+
+  // Request
+  uint32_t request_id() const { return header() ? header()->data.request_id : UNDEFINED_REQUEST; }
 
  private:
   static uint64_t current_time() { return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count(); }
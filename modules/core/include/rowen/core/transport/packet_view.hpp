@@ -0,0 +1,88 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <rowen/core/transport/packet_typedef.hpp>
+#include <vector>
+
+namespace rs {
+
+/**
+ * @brief Non-owning byte range
+ */
+struct PacketSpan
+{
+  const uint8_t* data = nullptr;
+  size_t         size = 0;
+};
+
+/**
+ * @brief Recycling pool of receive buffers (slab)
+ * @details acquire()로 얻은 slab은 마지막 참조가 해제될 때 pool로 반환된다.
+ *          pool이 먼저 해제된 경우 slab은 그대로 삭제된다.
+ */
+class PacketSlabPool : public std::enable_shared_from_this<PacketSlabPool>
+{
+ public:
+  using Slab    = std::vector<uint8_t>;
+  using SlabPtr = std::shared_ptr<Slab>;
+
+  static constexpr size_t DEFAULT_SLAB_SIZE     = 64 * 1024;
+  static constexpr size_t DEFAULT_MAX_IDLE_SLAB = 8;
+
+ public:
+  static std::shared_ptr<PacketSlabPool> create(size_t max_idle_slab = DEFAULT_MAX_IDLE_SLAB);
+
+  /**
+   * @brief Get empty slab which has at least `capacity` bytes
+   */
+  SlabPtr acquire(size_t capacity = DEFAULT_SLAB_SIZE);
+
+  size_t idle() const;
+
+ private:
+  explicit PacketSlabPool(size_t max_idle_slab) : max_idle_slab_(max_idle_slab) {}
+
+  void release(Slab* slab);
+
+ private:
+  const size_t                       max_idle_slab_;
+  mutable std::mutex                 idle_slab_locker_ = {};
+  std::vector<std::unique_ptr<Slab>> idle_slab_        = {};
+};
+
+/**
+ * @brief Zero-copy view of received packet
+ * @details 수신 버퍼(slab)를 공유하므로 복사가 발생하지 않으며, view가 살아있는 동안 데이터가 유지된다.
+ */
+class PacketView
+{
+ public:
+  PacketView() = default;
+  PacketView(std::shared_ptr<const void> slab, const uint8_t* data, size_t size)
+      : slab_(std::move(slab)), data_(data), size_(size) {}
+
+ public:
+  // Buffer (packet = header + payload + trailer)
+  const uint8_t* data() const { return data_; }
+  size_t         size() const { return size_; }
+  bool           empty() const { return size_ == 0; }
+
+  const uint8_t* begin() const { return data_; }
+  const uint8_t* end() const { return data_ + size_; }
+  uint8_t        operator[](size_t index) const { return data_[index]; }
+
+  // Packet
+  const Packet::Header*  header() const { return empty() ? nullptr : reinterpret_cast<const Packet::Header*>(data_); }
+  PacketSpan             payload() const { return empty() ? PacketSpan() : PacketSpan{ data_ + Packet::HEADER_SIZE, header()->data.payload_size }; }
+  const Packet::Trailer* trailer() const { return empty() ? nullptr : reinterpret_cast<const Packet::Trailer*>(data_ + size_ - Packet::TRAILER_SIZE); }
+
+  std::vector<uint8_t> to_vector() const { return std::vector<uint8_t>(begin(), end()); }
+
+ private:
+  std::shared_ptr<const void> slab_ = nullptr;
+  const uint8_t*              data_ = nullptr;
+  size_t                      size_ = 0;
+};
+
+};  // namespace rs
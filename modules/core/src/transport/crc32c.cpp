@@ -0,0 +1,166 @@
+#include <array>
+#include <cstring>
+#include <rowen/core/transport/crc32c.hpp>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+  #include <nmmintrin.h>
+  #define RS_CRC32C_X86
+#elif defined(__aarch64__) && defined(__linux__) && (defined(__GNUC__) || defined(__clang__))
+  #include <arm_acle.h>
+  #include <asm/hwcap.h>
+  #include <sys/auxv.h>
+  #define RS_CRC32C_ARM64
+#endif
+
+namespace rs {
+
+namespace {
+
+constexpr uint32_t CRC32C_POLYNOMIAL = 0x82F63B78;
+
+// --- slicing-by-8 ----------------------------------------------------------------
+using SliceTable = std::array<std::array<uint32_t, 256>, 8>;
+
+constexpr SliceTable make_slice_table()
+{
+  SliceTable table = {};
+
+  for (uint32_t i = 0; i < 256; ++i)
+  {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; ++bit)
+      crc = (crc >> 1) ^ ((crc & 1) ? CRC32C_POLYNOMIAL : 0);
+    table[0][i] = crc;
+  }
+
+  for (uint32_t i = 0; i < 256; ++i)
+  {
+    for (size_t slice = 1; slice < 8; ++slice)
+      table[slice][i] = (table[slice - 1][i] >> 8) ^ table[0][table[slice - 1][i] & 0xFF];
+  }
+
+  return table;
+}
+
+constexpr SliceTable SLICE_TABLE = make_slice_table();
+
+uint32_t crc32c_slicing_by_8(const uint8_t* data, size_t size, uint32_t crc)
+{
+  for (; size >= 8; size -= 8, data += 8)
+  {
+    uint32_t low, high;
+    std::memcpy(&low, data, sizeof(low));
+    std::memcpy(&high, data + 4, sizeof(high));
+    low ^= crc;  // (little endian)
+
+    crc = SLICE_TABLE[7][low & 0xFF] ^
+          SLICE_TABLE[6][(low >> 8) & 0xFF] ^
+          SLICE_TABLE[5][(low >> 16) & 0xFF] ^
+          SLICE_TABLE[4][low >> 24] ^
+          SLICE_TABLE[3][high & 0xFF] ^
+          SLICE_TABLE[2][(high >> 8) & 0xFF] ^
+          SLICE_TABLE[1][(high >> 16) & 0xFF] ^
+          SLICE_TABLE[0][high >> 24];
+  }
+
+  while (size-- > 0)
+    crc = (crc >> 8) ^ SLICE_TABLE[0][(crc ^ *data++) & 0xFF];
+
+  return crc;
+}
+
+// --- hardware --------------------------------------------------------------------
+#if defined(RS_CRC32C_X86)
+__attribute__((target("sse4.2"))) uint32_t crc32c_hardware(const uint8_t* data, size_t size, uint32_t crc)
+{
+  uint64_t crc64 = crc;
+
+  for (; size >= 8; size -= 8, data += 8)
+  {
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    crc64 = _mm_crc32_u64(crc64, value);
+  }
+
+  crc = static_cast<uint32_t>(crc64);
+
+  while (size-- > 0)
+    crc = _mm_crc32_u8(crc, *data++);
+
+  return crc;
+}
+
+bool crc32c_hardware_supported()
+{
+  return __builtin_cpu_supports("sse4.2");
+}
+
+constexpr auto CRC32C_HARDWARE_NAME = "sse4.2";
+
+#elif defined(RS_CRC32C_ARM64)
+  #if defined(__clang__)
+    #define RS_CRC32C_ARM64_TARGET __attribute__((target("crc")))
+  #else
+    #define RS_CRC32C_ARM64_TARGET __attribute__((target("+crc")))
+  #endif
+
+RS_CRC32C_ARM64_TARGET uint32_t crc32c_hardware(const uint8_t* data, size_t size, uint32_t crc)
+{
+  for (; size >= 8; size -= 8, data += 8)
+  {
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    crc = __crc32cd(crc, value);
+  }
+
+  while (size-- > 0)
+    crc = __crc32cb(crc, *data++);
+
+  return crc;
+}
+
+bool crc32c_hardware_supported()
+{
+  return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+}
+
+constexpr auto CRC32C_HARDWARE_NAME = "armv8-crc";
+
+#else
+uint32_t crc32c_hardware(const uint8_t* data, size_t size, uint32_t crc)
+{
+  return crc32c_slicing_by_8(data, size, crc);
+}
+
+bool crc32c_hardware_supported()
+{
+  return false;
+}
+
+constexpr auto CRC32C_HARDWARE_NAME = "slicing-by-8";
+#endif
+
+using Crc32cFunction = uint32_t (*)(const uint8_t*, size_t, uint32_t);
+
+const Crc32cFunction& crc32c_function()
+{
+  static const Crc32cFunction function = crc32c_hardware_supported() ? crc32c_hardware : crc32c_slicing_by_8;
+  return function;
+}
+
+}  // namespace
+
+uint32_t crc32c(const void* data, size_t size, uint32_t crc)
+{
+  if (data == nullptr || size == 0)
+    return crc;
+
+  return ~crc32c_function()(static_cast<const uint8_t*>(data), size, ~crc);
+}
+
+const char* crc32c_implementation()
+{
+  return crc32c_function() == crc32c_slicing_by_8 ? "slicing-by-8" : CRC32C_HARDWARE_NAME;
+}
+
+}  // namespace rs
@@ -0,0 +1,266 @@
+#include <cstring>
+#include <rowen/core/transport/lz_codec.hpp>
+
+namespace rs {
+
+namespace {
+
+constexpr size_t MIN_MATCH     = 4;
+constexpr size_t LAST_LITERALS = 5;   // 마지막 5 바이트는 항상 literal
+constexpr size_t MATCH_LIMIT   = 12;  // 마지막 12 바이트에서는 match를 시작하지 않는다
+constexpr size_t MAX_DISTANCE  = 65535;
+constexpr int    MAX_HASH_LOG  = 14;
+constexpr int    MIN_HASH_LOG  = 8;
+constexpr size_t WILD_COPY     = 16;  // 짧은 복사는 고정 크기로 복사한다 (버퍼 여유가 있는 경우)
+
+inline uint32_t read32(const uint8_t* pointer)
+{
+  uint32_t value;
+  std::memcpy(&value, pointer, sizeof(value));
+  return value;
+}
+
+inline uint64_t read64(const uint8_t* pointer)
+{
+  uint64_t value;
+  std::memcpy(&value, pointer, sizeof(value));
+  return value;
+}
+
+inline uint32_t hash(const uint32_t sequence, const int hash_log)
+{
+  return (sequence * 2654435761U) >> (32 - hash_log);
+}
+
+// 일치하는 바이트 수 (8 바이트 단위 비교)
+inline size_t count_match(const uint8_t* iter, const uint8_t* match, const uint8_t* limit)
+{
+  const uint8_t* begin = iter;
+
+  while (iter + sizeof(uint64_t) <= limit)
+  {
+    uint64_t diff = read64(iter) ^ read64(match);
+    if (diff != 0)
+      return iter - begin + (__builtin_ctzll(diff) >> 3);
+
+    iter += sizeof(uint64_t);
+    match += sizeof(uint64_t);
+  }
+
+  while (iter < limit && *iter == *match)
+  {
+    iter++;
+    match++;
+  }
+
+  return iter - begin;
+}
+
+inline uint8_t* write_length(uint8_t* output, size_t length)
+{
+  for (; length >= 255; length -= 255)
+    *output++ = 255;
+  *output++ = static_cast<uint8_t>(length);
+  return output;
+}
+
+// token + literal length + literal + (offset + match length)
+inline uint8_t* write_sequence(uint8_t* output, const uint8_t* output_end,
+                               const uint8_t* literal, const size_t literal_size, const size_t offset, const size_t match_size)
+{
+  const size_t required = 1 + (literal_size / 255 + 1) + literal_size + (match_size > 0 ? 2 + ((match_size - MIN_MATCH) / 255 + 1) : 0);
+  if (static_cast<size_t>(output_end - output) < required)
+    return nullptr;
+
+  uint8_t* token = output++;
+
+  *token = static_cast<uint8_t>((literal_size >= 15 ? 15 : literal_size) << 4);
+  if (literal_size >= 15)
+    output = write_length(output, literal_size - 15);
+
+  std::memcpy(output, literal, literal_size);
+  output += literal_size;
+
+  // last literals
+  if (match_size == 0)
+    return output;
+
+  *output++ = static_cast<uint8_t>(offset & 0xFF);
+  *output++ = static_cast<uint8_t>(offset >> 8);
+
+  const size_t length = match_size - MIN_MATCH;
+
+  *token |= static_cast<uint8_t>(length >= 15 ? 15 : length);
+  if (length >= 15)
+    output = write_length(output, length - 15);
+
+  return output;
+}
+
+}  // namespace
+
+size_t lz_compress(const uint8_t* source, const size_t size, uint8_t* destination, const size_t capacity)
+{
+  if (source == nullptr || destination == nullptr || size == 0)
+    return 0;
+
+  uint8_t*       output     = destination;
+  uint8_t* const output_end = destination + capacity;
+
+  const uint8_t* iter   = source;
+  const uint8_t* anchor = source;
+  const uint8_t* end    = source + size;
+
+  if (size > MATCH_LIMIT)
+  {
+    // 작은 입력은 작은 hash table을 사용한다 (초기화 비용)
+    int hash_log = MIN_HASH_LOG;
+    while (hash_log < MAX_HASH_LOG && (static_cast<size_t>(1) << hash_log) < size)
+      hash_log++;
+
+    uint32_t table[1 << MAX_HASH_LOG];
+    std::memset(table, 0, sizeof(uint32_t) << hash_log);
+
+    const uint8_t* match_start_limit = end - MATCH_LIMIT;
+    const uint8_t* match_limit       = end - LAST_LITERALS;
+
+    while (iter < match_start_limit)
+    {
+      const uint32_t sequence = read32(iter);
+      const uint32_t key      = hash(sequence, hash_log);
+      const uint8_t* match    = source + table[key];
+
+      table[key] = static_cast<uint32_t>(iter - source);
+
+      if (match >= iter || static_cast<size_t>(iter - match) > MAX_DISTANCE || read32(match) != sequence)
+      {
+        // match가 없는 구간은 점점 건너뛴다 (압축되지 않는 데이터)
+        iter += 1 + ((iter - anchor) >> 6);
+        continue;
+      }
+
+      // extend backward
+      while (iter > anchor && match > source && iter[-1] == match[-1])
+      {
+        iter--;
+        match--;
+      }
+
+      const size_t match_size = MIN_MATCH + count_match(iter + MIN_MATCH, match + MIN_MATCH, match_limit);
+
+      output = write_sequence(output, output_end, anchor, iter - anchor, iter - match, match_size);
+      if (output == nullptr)
+        return 0;
+
+      iter += match_size;
+      anchor = iter;
+
+      if (iter < match_start_limit)
+        table[hash(read32(iter - 2), hash_log)] = static_cast<uint32_t>(iter - 2 - source);
+    }
+  }
+
+  output = write_sequence(output, output_end, anchor, end - anchor, 0, 0);
+  if (output == nullptr)
+    return 0;
+
+  return output - destination;
+}
+
+ssize_t lz_decompress(const uint8_t* source, const size_t size, uint8_t* destination, const size_t capacity)
+{
+  if (source == nullptr || destination == nullptr || size == 0)
+    return -1;
+
+  const uint8_t* iter       = source;
+  const uint8_t* end        = source + size;
+  uint8_t*       output     = destination;
+  uint8_t* const output_end = destination + capacity;
+
+  auto read_length = [&](size_t& length) {
+    uint8_t value;
+    do
+    {
+      if (iter >= end)
+        return false;
+      value = *iter++;
+      length += value;
+    } while (value == 255);
+    return true;
+  };
+
+  while (iter < end)
+  {
+    const uint8_t token = *iter++;
+
+    // literal
+    size_t literal_size = token >> 4;
+    if (literal_size == 15 && !read_length(literal_size))
+      return -1;
+
+    if (literal_size > static_cast<size_t>(end - iter) || literal_size > static_cast<size_t>(output_end - output))
+      return -1;
+
+    if (literal_size <= WILD_COPY && static_cast<size_t>(end - iter) >= WILD_COPY && static_cast<size_t>(output_end - output) >= WILD_COPY)
+      std::memcpy(output, iter, WILD_COPY);
+    else
+      std::memcpy(output, iter, literal_size);
+
+    output += literal_size;
+    iter += literal_size;
+
+    // last literals
+    if (iter == end)
+      break;
+
+    // match
+    if (end - iter < 2)
+      return -1;
+
+    const size_t offset = iter[0] | (iter[1] << 8);
+    iter += 2;
+
+    if (offset == 0 || offset > static_cast<size_t>(output - destination))
+      return -1;
+
+    size_t match_size = token & 0x0F;
+    if (match_size == 15 && !read_length(match_size))
+      return -1;
+    match_size += MIN_MATCH;
+
+    if (match_size > static_cast<size_t>(output_end - output))
+      return -1;
+
+    const uint8_t* match = output - offset;
+
+    if (offset >= WILD_COPY && match_size <= WILD_COPY && static_cast<size_t>(output_end - output) >= WILD_COPY)
+    {
+      std::memcpy(output, match, WILD_COPY);
+      output += match_size;
+    }
+    else if (offset >= match_size)
+    {
+      std::memcpy(output, match, match_size);
+      output += match_size;
+    }
+    else if (offset >= sizeof(uint64_t))
+    {
+      // 8 바이트 단위로 복사해도 겹치지 않는다
+      uint8_t* match_end = output + match_size;
+      for (; output + sizeof(uint64_t) <= match_end; output += sizeof(uint64_t), match += sizeof(uint64_t))
+        std::memcpy(output, match, sizeof(uint64_t));
+      while (output < match_end)
+        *output++ = *match++;
+    }
+    else
+    {
+      // 반복 패턴 (run-length)
+      for (size_t i = 0; i < match_size; ++i)
+        *output++ = *match++;
+    }
+  }
+
+  return output - destination;
+}
+
+}  // namespace rs
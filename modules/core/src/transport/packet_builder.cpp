@@ -0,0 +1,169 @@
+#include <cstring>
+#include <memory>
+#include <rowen/core/transport/packet_builder.hpp>
+
+namespace rs {
+
+namespace {
+
+// thread-local buffer pool (builder 생성 시 가져오고 소멸 시 반환)
+class BuilderBufferPool
+{
+  static constexpr size_t MAX_IDLE_BUFFER = 4;
+
+ public:
+  std::vector<uint8_t>* acquire()
+  {
+    if (idle_.empty())
+      return new std::vector<uint8_t>();
+
+    auto buffer = idle_.back().release();
+    idle_.pop_back();
+    return buffer;
+  }
+
+  void release(std::vector<uint8_t>* buffer)
+  {
+    std::unique_ptr<std::vector<uint8_t>> released(buffer);
+
+    if (idle_.size() < MAX_IDLE_BUFFER)
+      idle_.push_back(std::move(released));
+  }
+
+ private:
+  std::vector<std::unique_ptr<std::vector<uint8_t>>> idle_;
+};
+
+thread_local BuilderBufferPool builder_buffer_pool;
+
+}  // namespace
+
+PacketBuilder::PacketBuilder() : pooled_(builder_buffer_pool.acquire())
+{
+  buffer_   = pooled_->data();
+  capacity_ = pooled_->size();
+}
+
+PacketBuilder::PacketBuilder(uint8_t* buffer, const size_t capacity) : buffer_(buffer), capacity_(buffer ? capacity : 0)
+{
+}
+
+PacketBuilder::~PacketBuilder()
+{
+  if (pooled_)
+    builder_buffer_pool.release(pooled_);
+}
+
+bool PacketBuilder::make(const uint16_t version, const uint8_t source, const uint8_t destination, const uint32_t opcode,
+                         const uint8_t* payload, const size_t payload_size)
+{
+  reset();
+
+  if (payload == nullptr || payload_size == 0)
+    return false;
+
+  if (reserve(Packet::PACKET_SIZE(payload_size)) == false)
+    return false;
+
+  size_ = Packet::serialize(buffer_, capacity_, version, source, destination, opcode, payload, payload_size);
+
+  return size_ > 0;
+}
+
+bool PacketBuilder::make(const int opcode, const uint8_t* payload, const size_t payload_size)
+{
+  return make(0, 0, 0, static_cast<uint32_t>(opcode), payload, payload_size);
+}
+
+bool PacketBuilder::make(const int opcode, const std::string& json_data)
+{
+  return make(opcode, reinterpret_cast<const uint8_t*>(json_data.c_str()), json_data.size());
+}
+
+bool PacketBuilder::makeCompressed(const uint16_t version, const uint8_t source, const uint8_t destination, const uint32_t opcode,
+                                   const uint8_t* payload, const size_t payload_size)
+{
+  reset();
+
+  if (payload == nullptr || payload_size == 0)
+    return false;
+
+  // user buffer는 압축하지 않은 크기만큼만 있어도 된다 (압축 결과가 들어가지 않으면 압축하지 않는다)
+  if (reserve(Packet::COMPRESSED_PACKET_BOUND(payload_size)) == false && reserve(Packet::PACKET_SIZE(payload_size)) == false)
+    return false;
+
+  size_ = Packet::serializeCompressed(buffer_, capacity_, version, source, destination, opcode, payload, payload_size);
+
+  return size_ > 0;
+}
+
+bool PacketBuilder::makeCompressed(const int opcode, const uint8_t* payload, const size_t payload_size)
+{
+  return makeCompressed(0, 0, 0, static_cast<uint32_t>(opcode), payload, payload_size);
+}
+
+bool PacketBuilder::makeCompressed(const int opcode, const std::string& json_data)
+{
+  return makeCompressed(opcode, reinterpret_cast<const uint8_t*>(json_data.c_str()), json_data.size());
+}
+
+uint8_t* PacketBuilder::prepare(const uint32_t opcode, const size_t payload_size)
+{
+  reset();
+
+  if (payload_size == 0 || reserve(Packet::PACKET_SIZE(payload_size)) == false)
+    return nullptr;
+
+  prepared_opcode_       = opcode;
+  prepared_payload_size_ = payload_size;
+
+  return buffer_ + Packet::HEADER_SIZE;
+}
+
+bool PacketBuilder::commit(const uint16_t version, const uint8_t source, const uint8_t destination)
+{
+  if (prepared_payload_size_ == 0)
+    return false;
+
+  // payload는 이미 제자리에 작성되어 있으므로 header, trailer만 작성된다
+  size_ = Packet::serialize(buffer_, capacity_, version, source, destination, prepared_opcode_,
+                            buffer_ + Packet::HEADER_SIZE, prepared_payload_size_);
+
+  prepared_opcode_       = 0;
+  prepared_payload_size_ = 0;
+
+  return size_ > 0;
+}
+
+void PacketBuilder::reset()
+{
+  size_                  = 0;
+  prepared_opcode_       = 0;
+  prepared_payload_size_ = 0;
+}
+
+void PacketBuilder::updateTimestamp(uint64_t microsec) const
+{
+  if (size_ == 0)
+    return;
+
+  std::memcpy(buffer_ + Packet::OFFSET_TIMESTAMP, &microsec, sizeof(uint64_t));
+}
+
+bool PacketBuilder::reserve(const size_t packet_size)
+{
+  if (capacity_ >= packet_size)
+    return true;
+
+  // user buffer는 늘릴 수 없다
+  if (pooled_ == nullptr)
+    return false;
+
+  pooled_->resize(packet_size);
+  buffer_   = pooled_->data();
+  capacity_ = pooled_->size();
+
+  return true;
+}
+
+}  // namespace rs
@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <rowen/core/transport/packet_dispatcher.hpp>
+
+namespace rs {
+
+PacketDispatcher::PacketDispatcher() : direct_slot_(new Slot[DIRECT_OPCODE_SIZE]) {}
+
+void PacketDispatcher::on(const uint32_t opcode, Function function, void* context)
+{
+  auto target = slot(opcode, true);
+
+  target->function = function;
+  target->context  = context;
+  target->storage  = nullptr;
+}
+
+void PacketDispatcher::off(const uint32_t opcode)
+{
+  auto target = slot(opcode, false);
+  if (target == nullptr)
+    return;
+
+  target->function = nullptr;
+  target->context  = nullptr;
+  target->storage  = nullptr;
+}
+
+bool PacketDispatcher::dispatch(const uint8_t* packet, const size_t size)
+{
+  if (packet == nullptr || size < static_cast<size_t>(Packet::PACKET_SIZE(0)))
+    return false;
+
+  auto& header = *reinterpret_cast<const Packet::Header*>(packet);
+  auto  target = slot(header.data.opcode, false);
+
+  // counter는 dispatch thread만 쓰므로 lock 없이 갱신한다 (다른 thread에서는 읽기만 한다)
+  if (target == nullptr || target->function == nullptr)
+  {
+    unhandled_.store(unhandled_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    // 수신 기록은 남긴다 (direct slot)
+    if (target == nullptr)
+      return false;
+  }
+
+  target->count.store(target->count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  target->bytes.store(target->bytes.load(std::memory_order_relaxed) + size, std::memory_order_relaxed);
+  target->last_timestamp.store(header.data.timestamp, std::memory_order_relaxed);
+
+  if (target->function == nullptr)
+    return false;
+
+  target->function(target->context, header, PacketSpan{ packet + Packet::HEADER_SIZE, header.data.payload_size });
+  return true;
+}
+
+bool PacketDispatcher::contains(const uint32_t opcode) const
+{
+  auto target = slot(opcode);
+  return target != nullptr && target->function != nullptr;
+}
+
+std::vector<PacketDispatcher::Statistics> PacketDispatcher::statistics() const
+{
+  std::vector<Statistics> result;
+
+  for (uint32_t opcode = 0; opcode < DIRECT_OPCODE_SIZE; ++opcode)
+  {
+    auto& target = direct_slot_[opcode];
+    if (target.function != nullptr || target.count.load(std::memory_order_relaxed) > 0)
+      result.push_back(snapshot(opcode, target));
+  }
+
+  for (auto& [opcode, target] : sparse_slot_)
+    result.push_back(snapshot(opcode, *target));
+
+  return result;
+}
+
+void PacketDispatcher::resetStatistics()
+{
+  auto reset = [](Slot& target) {
+    target.count.store(0, std::memory_order_relaxed);
+    target.bytes.store(0, std::memory_order_relaxed);
+    target.last_timestamp.store(0, std::memory_order_relaxed);
+  };
+
+  for (uint32_t opcode = 0; opcode < DIRECT_OPCODE_SIZE; ++opcode)
+    reset(direct_slot_[opcode]);
+
+  for (auto& sparse : sparse_slot_)
+    reset(*sparse.second);
+
+  unhandled_.store(0, std::memory_order_relaxed);
+}
+
+PacketDispatcher::Slot* PacketDispatcher::slot(const uint32_t opcode, bool create)
+{
+  if (opcode < DIRECT_OPCODE_SIZE)
+    return &direct_slot_[opcode];
+
+  auto iter = std::lower_bound(sparse_slot_.begin(), sparse_slot_.end(), opcode,
+                               [](const SparseSlot& sparse, const uint32_t value) { return sparse.first < value; });
+
+  if (iter != sparse_slot_.end() && iter->first == opcode)
+    return iter->second.get();
+
+  if (!create)
+    return nullptr;
+
+  return sparse_slot_.emplace(iter, opcode, std::make_unique<Slot>())->second.get();
+}
+
+const PacketDispatcher::Slot* PacketDispatcher::slot(const uint32_t opcode) const
+{
+  return const_cast<PacketDispatcher*>(this)->slot(opcode, false);
+}
+
+PacketDispatcher::Statistics PacketDispatcher::snapshot(const uint32_t opcode, const Slot& slot)
+{
+  Statistics statistics;
+  statistics.opcode         = opcode;
+  statistics.count          = slot.count.load(std::memory_order_relaxed);
+  statistics.bytes          = slot.bytes.load(std::memory_order_relaxed);
+  statistics.last_timestamp = slot.last_timestamp.load(std::memory_order_relaxed);
+  return statistics;
+}
+
+}  // namespace rs
@@ -0,0 +1,59 @@
+#include <rowen/core/transport/packet_gather.hpp>
+
+namespace rs {
+
+PacketGather::PacketGather(const int opcode, const uint8_t* payload, const size_t payload_size)
+{
+  make(opcode, payload, payload_size);
+}
+
+bool PacketGather::make(const uint16_t version, const uint8_t source, const uint8_t destination, const uint32_t opcode,
+                        const uint8_t* payload, const size_t payload_size, const bool with_checksum)
+{
+  payload_      = nullptr;
+  payload_size_ = 0;
+
+  if (payload == nullptr || payload_size == 0)
+    return false;
+
+  Packet::serializeHeader(header_, version, source, destination, opcode, payload_size);
+  Packet::serializeTrailer(trailer_, with_checksum ? Packet::checksum(payload, payload_size) : 0);
+
+  payload_      = payload;
+  payload_size_ = payload_size;
+
+  return true;
+}
+
+bool PacketGather::make(const int opcode, const uint8_t* payload, const size_t payload_size)
+{
+  return make(0, 0, 0, static_cast<uint32_t>(opcode), payload, payload_size);
+}
+
+void PacketGather::updateTimestamp(uint64_t microsec) const
+{
+  if (valid() == false)
+    return;
+
+  std::memcpy(header_ + Packet::OFFSET_TIMESTAMP, &microsec, sizeof(uint64_t));
+}
+
+void PacketGather::updateRequestId(uint32_t request_id) const
+{
+  if (valid() == false)
+    return;
+
+  std::memcpy(header_ + Packet::OFFSET_REQUEST_ID, &request_id, sizeof(uint32_t));
+}
+
+PacketGather::Segments PacketGather::segments() const
+{
+  if (valid() == false)
+    return {};
+
+  return { PacketSpan{ header_, Packet::HEADER_SIZE },
+           PacketSpan{ payload_, payload_size_ },
+           PacketSpan{ trailer_, Packet::TRAILER_SIZE } };
+}
+
+}  // namespace rs
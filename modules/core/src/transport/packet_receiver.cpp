@@ -1,21 +1,39 @@
 #include <algorithm>
+#include <cstring>
 #include <rowen/core/transport/packet_receiver.hpp>
+#include <rowen/core/transport/packet_scanner.hpp>
 
 namespace rs {
 
 void PacketReceiver::store(const uint8_t* buffer, const ssize_t size)
 {
   std::unique_lock<std::mutex> locker(progress_mutex_);
-  cache_receive_buffer_.insert(cache_receive_buffer_.end(), buffer, buffer + size);
+
+  decompressed_slab_.clear();
+
+  append(buffer, size);
 
   progress();
 }
 
+size_t PacketReceiver::store_and_drain(const uint8_t* buffer, const ssize_t size, Spans& packets)
+{
+  std::unique_lock<std::mutex> locker(progress_mutex_);
+
+  packets.clear();
+  decompressed_slab_.clear();
+
+  append(buffer, size);
+
+  progress(&packets);
+
+  return packets.size();
+}
+
 PacketReceiver::Result PacketReceiver::grab()
 {
-  std::lock_guard<std::mutex> locker(received_packet_locker_);
-  Result                      result = received_packet_buffer_;
-  received_packet_buffer_.clear();
+  Result result;
+  grab(result);
   return result;
 }
 
@@ -36,7 +54,17 @@ void PacketReceiver::clear()
 
   {
     std::lock_guard<std::mutex> locker(progress_mutex_);
-    cache_receive_buffer_.clear();
+
+    // PacketView가 참조 중인 slab은 비우지 않고 교체한다
+    if (cache_receive_buffer_.use_count() > 1)
+      cache_receive_buffer_ = slab_pool_->acquire();
+    else
+      cache_receive_buffer_->clear();
+
+    cache_read_offset_ = 0;
+    progress_header_   = false;
+
+    decompressed_slab_.clear();
   }
 }
 
@@ -50,117 +78,197 @@ void PacketReceiver::resetCallback()
   received_packet_callback_ = nullptr;
 }
 
-void PacketReceiver::progress()
+void PacketReceiver::attachDispatcher(PacketDispatcher* dispatcher)
+{
+  std::lock_guard<std::mutex> locker(progress_mutex_);
+
+  received_packet_dispatcher_ = dispatcher;
+}
+
+void PacketReceiver::resetDispatcher()
+{
+  attachDispatcher(nullptr);
+}
+
+void PacketReceiver::setVerifyChecksum(bool verify)
+{
+  std::lock_guard<std::mutex> locker(progress_mutex_);
+
+  verify_checksum_ = verify;
+}
+
+void PacketReceiver::append(const uint8_t* buffer, const size_t size)
+{
+  auto& cache = *cache_receive_buffer_;
+
+  // PacketView가 참조하지 않는 경우 : 그대로 당기고 추가
+  if (cache_receive_buffer_.use_count() == 1)
+  {
+    compact();
+    cache.insert(cache.end(), buffer, buffer + size);
+    return;
+  }
+
+  // PacketView가 참조 중인 경우 : 기존 데이터의 위치가 바뀌면 안된다 (여유 공간이 있으면 재할당 없이 추가)
+  if (cache.capacity() - cache.size() >= size)
+  {
+    cache.insert(cache.end(), buffer, buffer + size);
+    return;
+  }
+
+  // 여유 공간이 없으면 처리되지 않은 데이터만 새 slab으로 옮긴다 (기존 slab은 view가 모두 해제되면 pool로 반환)
+  const auto remain_size = cache.size() - cache_read_offset_;
+
+  auto slab = slab_pool_->acquire(std::max(remain_size + size, PacketSlabPool::DEFAULT_SLAB_SIZE));
+  slab->insert(slab->end(), cache.data() + cache_read_offset_, cache.data() + cache.size());
+  slab->insert(slab->end(), buffer, buffer + size);
+
+  cache_receive_buffer_ = std::move(slab);
+  cache_read_offset_    = 0;
+}
+
+PacketSlabPool::SlabPtr PacketReceiver::decompress(const uint8_t* packet)
+{
+  const auto original_size = rs::Packet::decompressedSize(packet);
+  if (original_size == 0)
+    return nullptr;
+
+  const auto packet_size = static_cast<size_t>(rs::Packet::PACKET_SIZE(original_size));
+
+  auto slab = slab_pool_->acquire(packet_size);
+  slab->resize(packet_size);
+
+  if (rs::Packet::decompress(packet, slab->data(), slab->size()) != packet_size)
+    return nullptr;
+
+  return slab;
+}
+
+void PacketReceiver::compact()
+{
+  auto& cache = *cache_receive_buffer_;
+
+  if (cache_read_offset_ == 0)
+    return;
+
+  const auto remain_size = cache.size() - cache_read_offset_;
+
+  // 남은 데이터가 이미 처리된 데이터보다 작을 때만 앞으로 당긴다 (이동 비용은 처리한 데이터 크기 이하로 상각된다)
+  if (remain_size == 0)
+  {
+    cache.clear();
+    cache_read_offset_ = 0;
+  }
+  else if (remain_size <= cache_read_offset_)
+  {
+    std::memmove(cache.data(), cache.data() + cache_read_offset_, remain_size);
+    cache.resize(remain_size);
+    cache_read_offset_ = 0;
+  }
+}
+
+void PacketReceiver::progress(Spans* drained)
 {
   while (true)
   {
-    try
+    const uint8_t* first = cache_receive_buffer_->data() + cache_read_offset_;
+    const uint8_t* last  = cache_receive_buffer_->data() + cache_receive_buffer_->size();
+
+    // Step 1. Find Packet Header
+    if (progress_header_ == false)
     {
-      // Step 1. Find Packet Header
-      if (progress_header_ == nullptr)
-      {
-        auto iter = cache_receive_buffer_.begin();
+      // SOH, STX, total_size를 함께 검사 (SIMD)
+      auto iter = rs::find_packet_header(first, last);
 
-        do
-        {
-          // Find SOH
-          iter = std::find(iter, cache_receive_buffer_.end(), Packet::SOH);
-
-          // If not found, wait for next data...
-          if (iter == cache_receive_buffer_.end())
-            break;
-
-          // If not enough data, wait for next data...
-          if (iter + rs::Packet::HEADER_SIZE > cache_receive_buffer_.end())
-            break;
-
-          // Check candidate header
-          auto header_candidate = reinterpret_cast<rs::Packet::Header*>(&(*iter));
-          if (header_candidate == nullptr)
-            break;
-
-          // Check candidate header validation
-          if (header_candidate->STX_ != rs::Packet::STX)
-          {
-            iter++;
-            continue;
-          }
-
-          if (header_candidate->data.opcode < 0 || header_candidate->data.payload_size < 0)
-          {
-            iter++;
-            continue;
-          }
-
-          if (header_candidate->data.total_size != rs::Packet::PACKET_SIZE(header_candidate->data.payload_size))
-          {
-            iter++;
-            continue;
-          }
-
-          // Find Packet !
-          // erase previous data to make SOH to first byte and make header to first byte
-          {
-            iter             = cache_receive_buffer_.erase(cache_receive_buffer_.begin(), iter);
-            progress_header_ = reinterpret_cast<rs::Packet::Header*>(&(*iter));
-            break;
-          }
-        } while (iter < cache_receive_buffer_.end());
-      }
+      // If not found or not enough data, wait for next data...
+      if (iter != last && last - iter >= rs::Packet::HEADER_SIZE)
+        progress_header_ = true;
 
-      // Assert Packet Header
-      if (progress_header_ == nullptr)
-        break;
+      // skip previous data to make SOH to first byte (header 후보가 될 수 없는 데이터)
+      cache_read_offset_ += iter - first;
+      first = iter;
+    }
 
-      // Step 2. Receive Packet Data until ETX
-      if (progress_header_ != nullptr)
-      {
-        rs::Packet::Header* packet_header = static_cast<rs::Packet::Header*>(progress_header_);
+    // Assert Packet Header
+    if (progress_header_ == false)
+      break;
+
+    // Step 2. Receive Packet Data until ETX
+    auto packet_header     = reinterpret_cast<const rs::Packet::Header*>(first);
+    auto total_packet_size = packet_header->data.total_size;
+
+    // Check receive buffer size is enough to process
+    if (static_cast<size_t>(last - first) < total_packet_size)
+      break;
+
+    // Check ETX (and checksum)
+    auto trailer = reinterpret_cast<const rs::Packet::Trailer*>(first + rs::Packet::HEADER_SIZE + packet_header->data.payload_size);
+    bool valid   = trailer->ETX_ == rs::Packet::ETX;
+
+    if (valid && verify_checksum_)
+      valid = trailer->data.crc32 == rs::Packet::checksum(first + rs::Packet::HEADER_SIZE, packet_header->data.payload_size);
+
+    // 잘못된 header (garbage 속의 SOH / STX) : SOH 다음 바이트부터 다시 찾는다 (total_size만큼 버리면 뒤따르는 실제 패킷을 잃는다)
+    if (valid == false)
+    {
+      cache_read_offset_ += 1;
+      progress_header_ = false;
+      continue;
+    }
 
-        auto total_packet_size = packet_header->data.total_size;
+    // Decompress payload (FLAG_COMPRESSED) into pooled slab
+    const uint8_t*          packet      = first;
+    size_t                  packet_size = total_packet_size;
+    PacketSlabPool::SlabPtr decompressed;
 
-        // Check receive buffer size is enough to process
-        if (cache_receive_buffer_.size() < total_packet_size)
-          break;
+    if (valid && (packet_header->data.flags & rs::Packet::FLAG_COMPRESSED))
+    {
+      decompressed = decompress(first);
+      valid        = decompressed != nullptr;
 
-        // Check ETX
-        auto trailer = reinterpret_cast<const rs::Packet::Trailer*>(cache_receive_buffer_.data() + rs::Packet::HEADER_SIZE + packet_header->data.payload_size);
-        if (trailer == nullptr || trailer->ETX_ != rs::Packet::ETX)
-          throw total_packet_size;
+      if (valid)
+      {
+        packet      = decompressed->data();
+        packet_size = decompressed->size();
+      }
+    }
 
+    if (valid)
+    {
+      try
+      {
         // Get data and return
-        if (received_packet_callback_)
+        if (drained)
         {
-          received_packet_callback_(cache_receive_buffer_.data(), total_packet_size);
+          drained->push_back({ packet, packet_size });
+
+          // Span이 유효한 동안 유지한다
+          if (decompressed)
+            decompressed_slab_.push_back(std::move(decompressed));
         }
-        else
+        else if (received_packet_dispatcher_)
         {
-          std::lock_guard<std::mutex> locker(received_packet_locker_);
-          received_packet_buffer_.emplace_back(cache_receive_buffer_.begin(), cache_receive_buffer_.begin() + total_packet_size);
+          received_packet_dispatcher_->dispatch(packet, packet_size);
         }
-
-        // Remove processed data
+        else if (received_packet_callback_)
         {
-          cache_receive_buffer_.erase(cache_receive_buffer_.begin(), cache_receive_buffer_.begin() + total_packet_size);
-          progress_header_ = nullptr;
+          received_packet_callback_(packet, packet_size);
+        }
+        else
+        {
+          std::lock_guard<std::mutex> locker(received_packet_locker_);
+          received_packet_buffer_.emplace_back(decompressed ? decompressed : cache_receive_buffer_, packet, packet_size);
         }
       }
-    }
-    catch (const decltype(Packet::Header::Data::total_size) drop_size)
-    {
-      // Drop
-      cache_receive_buffer_.erase(cache_receive_buffer_.begin(), cache_receive_buffer_.begin() + drop_size);
-      progress_header_ = nullptr;
-      break;
-    }
-    catch (...)
-    {
-      // Drop
-      progress_header_ = nullptr;
-      break;
+      catch (...)
+      {
+        // Drop
+      }
     }
 
-    usleep(1);
+    // Remove processed data (or drop packet that failed to decompress)
+    cache_read_offset_ += total_packet_size;
+    progress_header_ = false;
   }
 }
 
@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <rowen/core/transport/packet_scanner.hpp>
+#include <rowen/core/transport/packet_typedef.hpp>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+  #include <immintrin.h>
+  #define RS_SCANNER_X86
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+  #include <arm_neon.h>
+  #define RS_SCANNER_NEON
+#endif
+
+namespace rs {
+
+namespace {
+
+constexpr size_t STX_OFFSET = Packet::HEADER_SIZE - sizeof(Packet::STX);
+
+inline bool verify_header(const uint8_t* candidate)
+{
+  // size_t로 비교한다 (payload_size가 커도 total_size와 같아질 수 없다)
+  auto header = reinterpret_cast<const Packet::Header*>(candidate);
+  if (header->data.payload_size > Packet::MAX_PAYLOAD_SIZE)
+    return false;
+
+  return static_cast<size_t>(header->data.total_size) == static_cast<size_t>(Packet::PACKET_SIZE(static_cast<size_t>(header->data.payload_size)));
+}
+
+// header 전체를 검사할 수 없는 마지막 구간 (SOH만 찾는다)
+inline const uint8_t* find_tail(const uint8_t* iter, const uint8_t* last)
+{
+  for (; iter < last; ++iter)
+  {
+    if (*iter != Packet::SOH)
+      continue;
+
+    if (last - iter < Packet::HEADER_SIZE)
+      return iter;
+
+    if (iter[STX_OFFSET] == Packet::STX && verify_header(iter))
+      return iter;
+  }
+
+  return last;
+}
+
+const uint8_t* find_scalar(const uint8_t* first, const uint8_t* last)
+{
+  for (auto iter = first; iter < last; ++iter)
+  {
+    iter = std::find(iter, last, Packet::SOH);
+
+    if (iter == last || last - iter < Packet::HEADER_SIZE)
+      return iter;
+
+    if (iter[STX_OFFSET] == Packet::STX && verify_header(iter))
+      return iter;
+  }
+
+  return last;
+}
+
+#if defined(RS_SCANNER_X86)
+// 16 / 32 바이트 단위로 SOH(p)와 STX(p + STX_OFFSET)를 함께 비교한 mask에서 후보만 검사한다
+const uint8_t* find_sse2(const uint8_t* first, const uint8_t* last)
+{
+  constexpr ssize_t LANE = 16;
+
+  const __m128i soh = _mm_set1_epi8(Packet::SOH);
+  const __m128i stx = _mm_set1_epi8(Packet::STX);
+
+  auto iter = first;
+
+  for (; last - iter >= static_cast<ssize_t>(STX_OFFSET) + LANE; iter += LANE)
+  {
+    __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iter));
+    __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iter + STX_OFFSET));
+
+    uint32_t mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(head, soh), _mm_cmpeq_epi8(tail, stx)));
+
+    while (mask != 0)
+    {
+      auto candidate = iter + __builtin_ctz(mask);
+      if (verify_header(candidate))
+        return candidate;
+      mask &= mask - 1;
+    }
+  }
+
+  return find_tail(iter, last);
+}
+
+__attribute__((target("avx2"))) const uint8_t* find_avx2(const uint8_t* first, const uint8_t* last)
+{
+  constexpr ssize_t LANE = 32;
+
+  const __m256i soh = _mm256_set1_epi8(Packet::SOH);
+  const __m256i stx = _mm256_set1_epi8(Packet::STX);
+
+  auto iter = first;
+
+  for (; last - iter >= static_cast<ssize_t>(STX_OFFSET) + LANE; iter += LANE)
+  {
+    __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(iter));
+    __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(iter + STX_OFFSET));
+
+    uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(head, soh), _mm256_cmpeq_epi8(tail, stx)));
+
+    while (mask != 0)
+    {
+      auto candidate = iter + __builtin_ctz(mask);
+      if (verify_header(candidate))
+        return candidate;
+      mask &= mask - 1;
+    }
+  }
+
+  return find_tail(iter, last);
+}
+#endif
+
+#if defined(RS_SCANNER_NEON)
+const uint8_t* find_neon(const uint8_t* first, const uint8_t* last)
+{
+  constexpr ssize_t LANE = 16;
+
+  const uint8x16_t soh = vdupq_n_u8(Packet::SOH);
+  const uint8x16_t stx = vdupq_n_u8(Packet::STX);
+
+  auto iter = first;
+
+  for (; last - iter >= static_cast<ssize_t>(STX_OFFSET) + LANE; iter += LANE)
+  {
+    uint8x16_t matched = vandq_u8(vceqq_u8(vld1q_u8(iter), soh), vceqq_u8(vld1q_u8(iter + STX_OFFSET), stx));
+
+    // 바이트당 4bit mask (shift-right-narrow)
+    uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matched), 4)), 0);
+
+    while (mask != 0)
+    {
+      auto candidate = iter + (__builtin_ctzll(mask) >> 2);
+      if (verify_header(candidate))
+        return candidate;
+      mask &= ~(0xFULL << (__builtin_ctzll(mask) & ~3));
+    }
+  }
+
+  return find_tail(iter, last);
+}
+#endif
+
+using ScannerFunction = const uint8_t* (*)(const uint8_t*, const uint8_t*);
+
+struct Scanner
+{
+  ScannerFunction function;
+  const char*     name;
+};
+
+const Scanner& scanner()
+{
+  static const Scanner selected = [] {
+#if defined(RS_SCANNER_X86)
+    if (__builtin_cpu_supports("avx2"))
+      return Scanner{ find_avx2, "avx2" };
+    return Scanner{ find_sse2, "sse2" };
+#elif defined(RS_SCANNER_NEON)
+    return Scanner{ find_neon, "neon" };
+#else
+    return Scanner{ find_scalar, "scalar" };
+#endif
+  }();
+
+  return selected;
+}
+
+}  // namespace
+
+const uint8_t* find_packet_header(const uint8_t* first, const uint8_t* last)
+{
+  if (first == nullptr || first >= last)
+    return last;
+
+  return scanner().function(first, last);
+}
+
+const char* packet_scanner_implementation()
+{
+  return scanner().name;
+}
+
+}  // namespace rs
@@ -1,5 +1,7 @@
 
+#include <algorithm>
 #include <rowen/core/define/macro.hpp>
+#include <rowen/core/transport/crc32c.hpp>
 #include <rowen/core/transport/packet_typedef.hpp>
 
 namespace rs {
@@ -9,6 +11,29 @@ Packet::~Packet()
   RS_SAFE_DELETE_ARRAY(buffer_);
 }
 
+Packet::Packet(Packet&& other) noexcept
+    : buffer_(other.buffer_), buffer_size_(other.buffer_size_)
+{
+  other.buffer_      = nullptr;
+  other.buffer_size_ = UNDEFINED_SIZE;
+}
+
+Packet& Packet::operator=(Packet&& other) noexcept
+{
+  if (this != &other)
+  {
+    RS_SAFE_DELETE_ARRAY(buffer_);
+
+    buffer_      = other.buffer_;
+    buffer_size_ = other.buffer_size_;
+
+    other.buffer_      = nullptr;
+    other.buffer_size_ = UNDEFINED_SIZE;
+  }
+
+  return *this;
+}
+
 Packet::Packet(const int opcode, const std::string& json)
 {
   make(opcode, json);
@@ -37,28 +62,141 @@ bool Packet::make(const uint16_t version, const uint8_t source, const uint8_t de
   buffer_          = new uint8_t[packet_size];
   buffer_size_     = packet_size;
 
+  serialize(buffer_, packet_size, version, source, destination, opcode, payload, payload_size);
+
+  return true;
+}
+
+size_t Packet::serialize(uint8_t* buffer, const size_t capacity,
+                         const uint16_t version, const uint8_t source, const uint8_t destination, const uint32_t opcode,
+                         const uint8_t* payload, const size_t payload_size)
+{
+  if (buffer == nullptr || payload == nullptr || payload_size <= UNDEFINED_SIZE)
+    return 0;
+
+  const size_t packet_size = PACKET_SIZE(payload_size);
+  if (capacity < packet_size)
+    return 0;
+
   // Fill Header
+  serializeHeader(buffer, version, source, destination, opcode, payload_size);
+
+  // Fill Payload (payload가 이미 buffer 위치에 작성된 경우 복사하지 않는다)
+  if (payload != buffer + HEADER_SIZE)
+    std::memmove(buffer + HEADER_SIZE, payload, payload_size);
+
+  // Fill Trailer
+  serializeTrailer(buffer + HEADER_SIZE + payload_size, checksum(buffer + HEADER_SIZE, payload_size));
+
+  return packet_size;
+}
+
+size_t Packet::serializeCompressed(uint8_t* buffer, const size_t capacity,
+                                   const uint16_t version, const uint8_t source, const uint8_t destination, const uint32_t opcode,
+                                   const uint8_t* payload, const size_t payload_size)
+{
+  if (buffer == nullptr || payload == nullptr || payload_size <= UNDEFINED_SIZE)
+    return 0;
+
+  if (capacity < static_cast<size_t>(PACKET_SIZE(payload_size)))
+    return 0;
+
+  // payload가 buffer와 겹치는 경우(prepare 등)는 압축하지 않는다
+  const bool overlapped = payload < buffer + capacity && buffer < payload + payload_size;
+
+  // 압축된 payload (원본 크기 + 압축 데이터)가 원본보다 작은 경우만 압축한다
+  size_t compressed_size = 0;
+  if (!overlapped && payload_size > sizeof(uint32_t) + 1)
+  {
+    const size_t limit = std::min(capacity - HEADER_SIZE - TRAILER_SIZE, payload_size - 1) - sizeof(uint32_t);
+    compressed_size    = lz_compress(payload, payload_size, buffer + HEADER_SIZE + sizeof(uint32_t), limit);
+  }
+
+  if (compressed_size == 0)
+    return serialize(buffer, capacity, version, source, destination, opcode, payload, payload_size);
+
+  const uint32_t original_size      = static_cast<uint32_t>(payload_size);
+  const size_t   compressed_payload = sizeof(uint32_t) + compressed_size;
+
+  std::memcpy(buffer + HEADER_SIZE, &original_size, sizeof(uint32_t));
+
+  serializeHeader(buffer, version, source, destination, opcode, compressed_payload, FLAG_COMPRESSED);
+  serializeTrailer(buffer + HEADER_SIZE + compressed_payload, checksum(buffer + HEADER_SIZE, compressed_payload));
+
+  return PACKET_SIZE(compressed_payload);
+}
+
+size_t Packet::decompressedSize(const uint8_t* packet)
+{
+  if (packet == nullptr)
+    return 0;
+
+  auto header = reinterpret_cast<const Header*>(packet);
+  if ((header->data.flags & FLAG_COMPRESSED) == 0 || header->data.payload_size <= sizeof(uint32_t))
+    return 0;
+
+  uint32_t original_size;
+  std::memcpy(&original_size, packet + HEADER_SIZE, sizeof(uint32_t));
+
+  // 압축 데이터로 만들 수 없는 크기는 손상된 패킷으로 판단한다 (LZ 최대 압축률 약 255:1)
+  const size_t compressed_size = header->data.payload_size - sizeof(uint32_t);
+  if (original_size == 0 || original_size > compressed_size * 255 + 16 ||
+      original_size > static_cast<size_t>(INT32_MAX) - HEADER_SIZE - TRAILER_SIZE)
+    return 0;
+
+  return original_size;
+}
+
+size_t Packet::decompress(const uint8_t* packet, uint8_t* buffer, const size_t capacity)
+{
+  const size_t original_size = decompressedSize(packet);
+  if (original_size == 0 || buffer == nullptr || capacity < static_cast<size_t>(PACKET_SIZE(original_size)))
+    return 0;
+
+  auto       header          = reinterpret_cast<const Header*>(packet);
+  const auto compressed_size = header->data.payload_size - sizeof(uint32_t);
+
+  if (lz_decompress(packet + HEADER_SIZE + sizeof(uint32_t), compressed_size, buffer + HEADER_SIZE, original_size) !=
+      static_cast<ssize_t>(original_size))
+    return 0;
+
+  // Header (version, source, destination, timestamp, opcode 유지)
+  std::memcpy(buffer, packet, HEADER_SIZE);
+
+  auto decompressed = reinterpret_cast<Header*>(buffer);
+  decompressed->data.flags &= ~FLAG_COMPRESSED;
+  decompressed->data.payload_size = original_size;
+  decompressed->data.total_size   = PACKET_SIZE(original_size);
+
+  // Trailer
+  serializeTrailer(buffer + HEADER_SIZE + original_size, checksum(buffer + HEADER_SIZE, original_size));
+
+  return PACKET_SIZE(original_size);
+}
+
+void Packet::serializeHeader(uint8_t* buffer,
+                             const uint16_t version, const uint8_t source, const uint8_t destination, const uint32_t opcode,
+                             const size_t payload_size, const uint8_t flags)
+{
   // clang-format off
     struct Header header;
     if (version > UNDEFINED_VERSION)        header.data.version = version;
     if (source > UNDEFINED_TRANSPORT)       header.data.source = source;
     if (destination > UNDEFINED_TRANSPORT)  header.data.destination = destination;
     if (opcode > UNDEFINED_OPCODE)          header.data.opcode = opcode;
-    header.data.total_size = packet_size;
+    header.data.total_size = PACKET_SIZE(payload_size);
     header.data.payload_size = payload_size;
     header.data.timestamp = current_time();
+    header.data.flags = flags;
   // clang-format on
-  std::memcpy(buffer_, &header, HEADER_SIZE);
-
-  // Fill Payload
-  std::memcpy(buffer_ + HEADER_SIZE, payload, payload_size);
+  std::memcpy(buffer, &header, HEADER_SIZE);
+}
 
-  // Fill Trailer
+void Packet::serializeTrailer(uint8_t* buffer, const uint32_t crc32)
+{
   struct Trailer trailer;
-  trailer.data.crc32 = 0;  // TODO : Calculate CRC
-  std::memcpy(buffer_ + HEADER_SIZE + payload_size, &trailer, TRAILER_SIZE);
-
-  return true;
+  trailer.data.crc32 = crc32;
+  std::memcpy(buffer, &trailer, TRAILER_SIZE);
 }
 
 bool Packet::make(const int opcode, const uint8_t* payload, const size_t payload_size)
@@ -76,6 +214,33 @@ bool Packet::make(const int opcode, const std::string& json_data)
   return make(opcode, reinterpret_cast<const uint8_t*>(json_data.c_str()), json_data.size());
 }
 
+bool Packet::makeCompressed(const uint16_t version, const uint8_t source, const uint8_t destination, const uint32_t opcode,
+                            const uint8_t* payload, const size_t payload_size)
+{
+  if (payload == nullptr || payload_size <= UNDEFINED_SIZE)
+    return false;
+
+  // Reset buffer
+  RS_SAFE_DELETE_ARRAY(buffer_);
+
+  // 최대 크기로 할당 (실제 패킷 크기는 압축 결과에 따른다)
+  auto capacity = COMPRESSED_PACKET_BOUND(payload_size);
+  buffer_       = new uint8_t[capacity];
+  buffer_size_  = serializeCompressed(buffer_, capacity, version, source, destination, opcode, payload, payload_size);
+
+  return buffer_size_ > 0;
+}
+
+bool Packet::makeCompressed(const int opcode, const uint8_t* payload, const size_t payload_size)
+{
+  return makeCompressed(UNDEFINED_VERSION, UNDEFINED_TRANSPORT, UNDEFINED_TRANSPORT, static_cast<uint32_t>(opcode), payload, payload_size);
+}
+
+bool Packet::makeCompressed(const int opcode, const std::string& json_data)
+{
+  return makeCompressed(opcode, reinterpret_cast<const uint8_t*>(json_data.c_str()), json_data.size());
+}
+
 bool Packet::fill(const uint8_t* packet_byte_stream, const size_t byte_stream_size)
 {
   if (packet_byte_stream == nullptr || byte_stream_size <= UNDEFINED_SIZE)
@@ -99,7 +264,12 @@ bool Packet::fill(const std::vector<uint8_t>& packet_byte_stream)
   return Packet::fill(packet_byte_stream.data(), packet_byte_stream.size());
 }
 
-bool Packet::validation() const
+uint32_t Packet::checksum(const uint8_t* payload, const size_t payload_size)
+{
+  return rs::crc32c(payload, payload_size);
+}
+
+bool Packet::validation(bool verify_checksum) const
 {
   if (buffer_ == nullptr || buffer_size_ <= UNDEFINED_SIZE)
     return false;
@@ -132,6 +302,9 @@ bool Packet::validation() const
   {
     if (trailer_ptr->ETX_ != ETX)
       return false;
+
+    if (verify_checksum && trailer_ptr->data.crc32 != checksum(payload(), payload_size()))
+      return false;
   }
 
   return true;
@@ -169,4 +342,12 @@ void Packet::updateTimestamp(uint64_t microsec) const
   std::memcpy(buffer_ + OFFSET_TIMESTAMP, &microsec, sizeof(uint64_t));
 }
 
+void Packet::updateRequestId(uint32_t request_id) const
+{
+  if (buffer_ == nullptr)
+    return;
+
+  std::memcpy(buffer_ + OFFSET_REQUEST_ID, &request_id, sizeof(uint32_t));
+}
+
 }  // namespace rs
@@ -0,0 +1,58 @@
+#include <rowen/core/transport/packet_view.hpp>
+
+namespace rs {
+
+std::shared_ptr<PacketSlabPool> PacketSlabPool::create(size_t max_idle_slab)
+{
+  return std::shared_ptr<PacketSlabPool>(new PacketSlabPool(max_idle_slab));
+}
+
+PacketSlabPool::SlabPtr PacketSlabPool::acquire(size_t capacity)
+{
+  std::unique_ptr<Slab> slab = nullptr;
+
+  {
+    std::lock_guard<std::mutex> locker(idle_slab_locker_);
+
+    if (idle_slab_.empty() == false)
+    {
+      slab = std::move(idle_slab_.back());
+      idle_slab_.pop_back();
+    }
+  }
+
+  if (slab == nullptr)
+    slab = std::make_unique<Slab>();
+
+  slab->reserve(capacity);
+
+  // 마지막 참조가 해제되면 pool로 반환 (pool이 해제된 경우 삭제)
+  std::weak_ptr<PacketSlabPool> weak_pool = shared_from_this();
+
+  return SlabPtr(slab.release(), [weak_pool](Slab* released) {
+    if (auto pool = weak_pool.lock())
+      pool->release(released);
+    else
+      delete released;
+  });
+}
+
+size_t PacketSlabPool::idle() const
+{
+  std::lock_guard<std::mutex> locker(idle_slab_locker_);
+
+  return idle_slab_.size();
+}
+
+void PacketSlabPool::release(Slab* slab)
+{
+  std::unique_ptr<Slab> released(slab);
+  released->clear();
+
+  std::lock_guard<std::mutex> locker(idle_slab_locker_);
+
+  if (idle_slab_.size() < max_idle_slab_)
+    idle_slab_.push_back(std::move(released));
+}
+
+}  // namespace rs
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <unistd.h>
 
 #include <cstdint>
 #include <rowen/core/exception.hpp>
+#include <rowen/core/transport/packet_gather.hpp>
 #include <rowen/core/transport/packet_typedef.hpp>
 #include <string>
 
@@ -18,6 +20,7 @@ static constexpr int DEFAULT_SEND_BUFFER_SIZE = 1024;
 static constexpr int DEFAULT_SEND_FLAG        = 0;
 static constexpr int DEFAULT_RECV_BUFFER_SIZE = 8192;
 static constexpr int DEFAULT_RECV_FLAG        = 0;
+static constexpr int MAX_SEND_IOVEC           = 16;
 
 class Socket
 {
@@ -66,6 +69,26 @@ class Socket
   ssize_t send(const rs::Packet& packet, int flags = -1,
                const struct sockaddr* address = nullptr, socklen_t addr_len = -1) const;
 
+  /*
+  * @brief send scattered data at once (sendmsg)
+  * @param iov : data buffers
+  * @param iov_count : number of data buffers (up to MAX_SEND_IOVEC)
+  * @param flags : socket flags
+  * @param address : receiver address (IF socket is based on SOCK_DGRAM, otherwise nullptr)
+  * @param addr_len : receiver address length (IF socket is based on SOCK_DGRAM, otherwise -1)
+  * @return sent data size (same as send())
+  */
+  ssize_t send(const struct iovec* iov, int iov_count, int flags = -1,
+               const struct sockaddr* address = nullptr, socklen_t addr_len = -1) const;
+
+  /*
+  * @brief send gather packet (header, payload, trailer) with single sendmsg
+  * @param packet : gather packet (payload is not copied)
+  * @return sent data size (same as send())
+  */
+  ssize_t send(const rs::PacketGather& packet, int flags = -1,
+               const struct sockaddr* address = nullptr, socklen_t addr_len = -1) const;
+
   /*
   * @brief receive data
   * @param data : data buffer
@@ -394,6 +417,129 @@ inline ssize_t Socket::send(const rs::Packet& packet, int flags, const struct so
   return send(packet.data(), packet.size(), flags, address, addr_len);
 }
 
+inline ssize_t Socket::send(const struct iovec* iov, int iov_count, int flags, const struct sockaddr* address, socklen_t addr_len) const
+{
+  constexpr int MAX_RETRY = 3;
+
+  ssize_t total_send_size = 0;
+
+  try
+  {
+    if (this->valid() == false)
+      throw rs::exception("invalid socket handle");
+
+    if (iov == nullptr || iov_count <= 0 || iov_count > MAX_SEND_IOVEC)
+      throw rs::exception("invalid data buffer");
+
+    if (this->type() == SOCK_DGRAM && (address == nullptr || addr_len <= 0))
+      throw rs::exception("invalid address");
+
+    // 부분 전송 시 남은 영역을 가리키도록 복사해서 사용한다
+    struct iovec vectors[MAX_SEND_IOVEC];
+    size_t       size = 0;
+
+    for (int i = 0; i < iov_count; ++i)
+    {
+      vectors[i] = iov[i];
+      size += iov[i].iov_len;
+    }
+
+    if (size <= 0)
+      throw rs::exception("invalid data size");
+
+    struct msghdr message = {};
+    message.msg_iov       = vectors;
+    message.msg_iovlen    = iov_count;
+
+    if (this->type() == SOCK_DGRAM)
+    {
+      message.msg_name    = const_cast<struct sockaddr*>(address);
+      message.msg_namelen = addr_len;
+    }
+
+    // --- send data -------------------------------------------------------------
+    int flag  = flags < 0 ? props_.send.base_flags : flags;
+    int retry = 0;
+
+    while (total_send_size < static_cast<ssize_t>(size))
+    {
+      ssize_t send_size = ::sendmsg(handle_, &message, flag);
+
+      // --- error handling ------------------------------------------------------
+      if (send_size > 0)
+      {
+        retry = 0;
+        total_send_size += send_size;
+
+        // skip sent buffers
+        while (message.msg_iovlen > 0 && static_cast<size_t>(send_size) >= message.msg_iov->iov_len)
+        {
+          send_size -= message.msg_iov->iov_len;
+          message.msg_iov++;
+          message.msg_iovlen--;
+        }
+
+        if (message.msg_iovlen > 0)
+        {
+          message.msg_iov->iov_base = static_cast<uint8_t*>(message.msg_iov->iov_base) + send_size;
+          message.msg_iov->iov_len -= send_size;
+        }
+      }
+      else
+      {
+        if (++retry >= MAX_RETRY)
+          break;
+      }
+    }
+
+    // --- error handling --------------------------------------------------------
+    if (total_send_size != static_cast<ssize_t>(size))
+    {
+      // 재접속이 필요한 경우와 관련된 에러 코드
+      if (errno == EPIPE ||
+          errno == ECONNABORTED ||
+          errno == ECONNREFUSED ||
+          errno == ETIMEDOUT ||
+          errno == ENETRESET ||
+          errno == ECONNRESET ||
+          errno == ENOTCONN ||
+          errno == ENETDOWN ||
+          errno == EHOSTDOWN ||
+          errno == EHOSTUNREACH)
+      {
+        total_send_size = 0;
+      }
+      else
+      {
+        total_send_size = -1;  // 사용자 측에서 에러 처리를 위해 초기화
+      }
+
+      throw rs::exception(::strerror(errno));
+    }
+  }
+  catch (const rs::exception& e)
+  {
+    error_message_ = e.what();
+  }
+
+  return total_send_size;
+}
+
+inline ssize_t Socket::send(const rs::PacketGather& packet, int flags, const struct sockaddr* address, socklen_t addr_len) const
+{
+  struct iovec iov[3];
+  int          iov_count = 0;
+
+  for (const auto& segment : packet.segments())
+  {
+    iov[iov_count].iov_base = const_cast<uint8_t*>(segment.data);
+    iov[iov_count].iov_len  = segment.size;
+    iov_count++;
+  }
+
+  return send(iov, iov_count, flags, address, addr_len);
+}
+
 inline ssize_t Socket::recv(void* data, size_t size, int flags, struct sockaddr* address, socklen_t* addr_len) const
 {
   ssize_t read_size = 0;
@@ -26,6 +26,7 @@ class listener
     int   backlog                 = 5;
     bool  using_rs_packet         = false;
     bool  trace_rs_packet         = false;
+    bool  verify_rs_packet        = false;  // rs packet checksum(CRC32C) 검사
     float listener_select_timeout = 1;  // timeout is seconds
     int   listener_buffer_size    = DEFAULT_RECV_BUFFER_SIZE;
     int   listener_recv_timeout   = 0;
@@ -198,7 +198,10 @@ void listener::onReceiveMessage(const argument& args)
       if (args.using_rs_packet)
       {
         if (rs_packet_receiver_.find(new_client) == rs_packet_receiver_.end())
+        {
           rs_packet_receiver_[new_client] = std::make_unique<PacketReceiver>();
+          rs_packet_receiver_[new_client]->setVerifyChecksum(args.verify_rs_packet);
+        }
       }
     }
 
@@ -1,11 +1,21 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 namespace rs {
 namespace network {
 
+/**
+ * @brief Network interface query
+ * @details 인터페이스 (이름, MAC), 주소, 서브넷 마스크, 게이트웨이를 netlink (RTM_NEWLINK / RTM_NEWADDR / RTM_NEWROUTE)로 구독하여
+ *          메모리 snapshot으로 유지한다. 커널이 변경을 알리면 monitor thread가 바뀐 항목만 갱신한 뒤 새 snapshot을 게시한다.
+ *          조회 함수는 snapshot만 읽는다 (lock-free, system call 없음).
+ *          netlink를 사용할 수 없으면 조회마다 getifaddrs / ioctl / /proc/net/route를 읽는다.
+ */
 class config
 {
   constexpr static auto auto_select = "auto";      // 자동 선택
@@ -14,7 +24,17 @@ class config
  public:
   using Ethernets = std::vector<std::string>;
 
+  config();
+  ~config();
+
+  /**
+   * @brief Stop interface monitor and clear snapshot
+   */
   static void release();
+
+  /**
+   * @brief (Re)start interface monitor and load snapshot (조회 함수를 처음 호출할 때 자동으로 호출된다)
+   */
   static void configure();
 
   static Ethernets   InterfaceList();
@@ -23,16 +43,40 @@ class config
   static std::string Gateway(const std::string& interface = auto_select);
   static std::string SubnetMask(const std::string& interface = auto_select);
 
-  static std::string LastError() { return instance_.last_error_; }
+  static std::string LastError();
 
  private:
+  struct Interface;
+  struct Snapshot;
+  class Monitor;
+
+  static void start();
+
+  static bool find_interface(const char* caller, const std::string& interface, std::string Interface::*field, std::string& value);
+
+  static void publish(const Snapshot* snapshot);
+  static void reclaim();
+
+  static void set_error(const std::string& error);
+
   static std::string auto_select_interface(const std::string& interface = auto_select, bool retry = false);
 
  private:
   static config instance_;
 
-  std::vector<std::string> available_interfaces_;
+  std::mutex               mutex_;                 // configure, release, available_interfaces_
+  std::vector<std::string> available_interfaces_;  // netlink를 사용할 수 없을 때
+  std::mutex               error_mutex_;
   std::string              last_error_;
+
+  // snapshot_ : 현재 snapshot (monitor thread가 교체한다)
+  // readers_ : snapshot을 읽고 있는 thread 수 (0일 때만 교체된 snapshot을 해제한다)
+  // retired_ : 교체된 snapshot (monitor thread only)
+  std::unique_ptr<Monitor>     monitor_;
+  std::atomic_bool             configured_ = false;
+  std::atomic<const Snapshot*> snapshot_   = nullptr;
+  std::atomic<int>             readers_    = 0;
+  std::vector<const Snapshot*> retired_    = {};
 };
 
 };  // namespace network
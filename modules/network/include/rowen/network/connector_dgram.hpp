@@ -2,6 +2,7 @@
 
 #include <mutex>
 #include <rowen/core/transport/packet_receiver.hpp>
+#include <rowen/core/transport/packet_view.hpp>
 #include <rowen/network/detail/connector.hpp>
 
 namespace rs {
@@ -9,6 +10,9 @@ namespace network {
 
 class dgram_connector : public template_connector
 {
+ public:
+  static constexpr size_t MAX_SEND_BATCH = 64;  // datagrams per sendmmsg
+
  public:
   struct argument
   {
@@ -19,6 +23,10 @@ class dgram_connector : public template_connector
     int   send_buffer_size = DEFAULT_SEND_BUFFER_SIZE;
     float recv_timeout     = 0;  // timeout is seconds
     int   recv_flags       = MSG_NOSIGNAL;
+
+    // UDP GSO (UDP_SEGMENT) : segment_size 보다 큰 데이터는 kernel이 segment_size 크기의 datagram으로 나누어 전송한다
+    // 0 : 사용하지 않음 (e.g. 1472 : MTU 1500 - IPv4 header - UDP header)
+    int send_segment_size = 0;
   };
 
  public:
@@ -32,8 +40,19 @@ class dgram_connector : public template_connector
                   const int          server_port,
                   const argument&    arguments = default_arguments_);
 
+  /**
+   * @brief UDP GSO segment size (0 if not used)
+   */
+  int segment_size() const { return segment_size_; }
+
+  /**
+   * @brief true if kernel splits datagrams (UDP GSO). 경로가 GSO를 지원하지 않으면 (EIO) false가 되고 datagram을 직접 나누어 전송한다
+   */
+  bool segment_offload() const { return segment_offload_; }
+
   /**
    * @brief Send data to server (from preset)
+   * @details send_segment_size가 설정되어 있으면 segment_size 단위의 datagram으로 나뉘어 도착한다
    */
   ssize_t sendto(const uint8_t* data, size_t size, int send_flags = -1);
 
@@ -52,6 +71,19 @@ class dgram_connector : public template_connector
    */
   ssize_t sendto(const rs::Packet& packet, const struct sockaddr* addr, const socklen_t addrlen, int send_flags = -1);
 
+  /**
+   * @brief Send datagrams to server at once (from preset, sendmmsg)
+   * @param datagrams : datagram buffers (each buffer is sent as one datagram)
+   * @param count : number of datagrams
+   * @return number of sent datagrams (-1 if error)
+   */
+  ssize_t sendto_batch(const rs::PacketSpan* datagrams, size_t count, int send_flags = -1);
+
+  /**
+   * @brief Send datagrams at once (sendmmsg)
+   */
+  ssize_t sendto_batch(const rs::PacketSpan* datagrams, size_t count, const struct sockaddr* addr, const socklen_t addrlen, int send_flags = -1);
+
   /**
    * @brief Receive data from server (from preset)
    */
@@ -62,13 +94,20 @@ class dgram_connector : public template_connector
    */
   ssize_t recvfrom(uint8_t* data, size_t size, struct sockaddr* addr, socklen_t* addrlen, int recv_flags = -1);
 
+ private:
+  // connector_locker_를 잡은 상태에서 호출한다
+  ssize_t send_batch(const rs::PacketSpan* datagrams, size_t count, const struct sockaddr* addr, const socklen_t addrlen, int send_flags);
+
+  // segment_size_ 단위의 datagram으로 나누어 sendmmsg로 전송한다 (GSO를 사용할 수 없을 때)
+  ssize_t send_split(const uint8_t* data, size_t size, const struct sockaddr* addr, const socklen_t addrlen, int send_flags);
+
  private:
   static const argument default_arguments_;
 
  private:
-  sockaddr_in server_addr_      = {};
-  socklen_t   server_addr_len_  = sizeof(server_addr_);
-  std::mutex  connector_locker_ = {};
+  uint16_t   segment_size_     = 0;
+  bool       segment_offload_  = false;  // UDP_SEGMENT (GSO)
+  std::mutex connector_locker_ = {};
 };
 
 };  // namespace network
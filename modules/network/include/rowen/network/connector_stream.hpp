@@ -1,18 +1,40 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
 #include <mutex>
 #include <rowen/core/transport/packet_typedef.hpp>
 #include <rowen/network/detail/connector.hpp>
+#include <rowen/network/detail/uring.hpp>
 
 namespace rs {
 namespace network {
 
 class stream_connector : public template_connector
 {
+ public:
+  // send path
+  enum class backend
+  {
+    socket,    // send(), sendmsg()
+    io_uring,  // io_uring SEND (gather packet은 linked SEND chain. 지원하지 않는 kernel은 socket)
+  };
+
+  // 연결이 끊어진 동안 offline buffer가 가득 찼을 때
+  enum class drop_policy
+  {
+    drop_newest,  // 새 데이터를 버린다 (send() returns -1)
+    drop_oldest,  // 가장 오래된 데이터를 버린다
+  };
+
  public:
   struct argument
   {
+    backend connector_backend = backend::socket;
+
     int   socket_protocol = 0;
     float connect_timeout = 1;  // timeout is seconds
 
@@ -23,11 +45,29 @@ class stream_connector : public template_connector
     float recv_timeout     = 0;  // timeout is seconds
     int   recv_flags       = MSG_NOSIGNAL;
     bool  recv_retry       = false;  // timeout이 설정되어 있을 때 retry 여부
+
+    // TCP option (TcpProfile::latency(), TcpProfile::throughput(), ...). 적용된 값은 socket().tcpProfile()로 확인한다
+    TcpProfile tcp_profile = {};
+
+    // asynchronous reconnect : 연결이 끊어지면 background thread가 non-blocking connect로 재접속한다
+    // (send()는 재접속을 기다리지 않는다. 재접속 간격은 backoff_min부터 2배씩 backoff_max까지 늘어나며 ±jitter 비율만큼 흔들린다)
+    bool  reconnect_async       = false;
+    float reconnect_backoff_min = 0.1;  // timeout is seconds
+    float reconnect_backoff_max = 10;   // timeout is seconds
+    float reconnect_jitter      = 0.2;  // 0 ~ 1
+
+    // 연결이 끊어진 동안 send() 데이터를 보관하고 재접속 후 순서대로 전송한다 (reconnect_async, 0 : 보관하지 않음)
+    size_t      offline_buffer_size = 0;  // bytes
+    drop_policy offline_drop_policy = drop_policy::drop_newest;
   };
 
  public:
+  stream_connector() = default;
+  ~stream_connector() override;
+
   /**
    * @brief Initialize connector configuration (Optional. Use connect() instead)
+   * @details reconnect_async이면 background thread가 접속을 시작한다 (blocking 없음)
    * @param domain_file : absolute path like "/tmp/domain.sock"
    * @param argument : connector argument
    */
@@ -37,6 +77,7 @@ class stream_connector : public template_connector
 
   /**
    * @brief Connect to server
+   * @details reconnect_async이면 접속에 실패해도 background thread가 재접속을 계속한다
    * @param server_address : server address
    * @param server_port : server port
    * @param argument : connector argument
@@ -46,7 +87,7 @@ class stream_connector : public template_connector
                const argument&    arguments = default_arguments_);
 
   /**
-   * @brief Disconnect from server
+   * @brief Disconnect from server (background reconnect is stopped)
    */
   void disconnect();
 
@@ -56,8 +97,25 @@ class stream_connector : public template_connector
    */
   bool isConnected() const { return connected_; }
 
+  /**
+   * @brief Check send path of connection
+   * @return true if send is submitted by io_uring
+   */
+  bool using_io_uring() const { return uring_ != nullptr; }
+
+  /**
+   * @brief Data size which is waiting for reconnection (offline buffer)
+   */
+  size_t offline_size() const;
+
+  /**
+   * @brief Number of send() data which is dropped by offline buffer
+   */
+  uint64_t offline_dropped() const { return offline_dropped_; }
+
   /**
    * @brief Send data to server
+   * @details reconnect_async이면 연결이 끊어진 동안 offline buffer에 보관하고 size를 반환한다 (보관할 수 없으면 0 or -1)
    */
   ssize_t send(const uint8_t* data, size_t size, int send_flags = -1, int retry_flag = -1);
 
@@ -66,6 +124,11 @@ class stream_connector : public template_connector
    */
   ssize_t send(const rs::Packet& packet, int send_flags = -1, int retry_flag = -1);
 
+  /**
+   * @brief Send data to server (with rs gather packet. payload is not copied)
+   */
+  ssize_t send(const rs::PacketGather& packet, int send_flags = -1, int retry_flag = -1);
+
   /**
    * @brief Receive data from server
    */
@@ -80,7 +143,34 @@ class stream_connector : public template_connector
                      int send_flags = -1, int recv_flags = -1);
 
  private:
-  ssize_t try_send(const uint8_t* data, size_t size, int send_flags = -1);
+  template <typename Data>
+  ssize_t send_with_retry(const Data& data, int send_flags, int retry_flag);
+
+  template <typename Data>
+  ssize_t try_send(const Data& data, int send_flags = -1);
+
+  ssize_t uring_send(const PacketSpan* segments, size_t count, int send_flags);
+
+  bool open_connection(const argument& args, bool wait_forever);
+
+  bool activate_connection();
+
+  void close_connection();
+
+  // asynchronous reconnect
+  template <typename Data>
+  ssize_t send_or_buffer(const Data& data, int send_flags);
+
+  template <typename Data>
+  ssize_t buffer_offline(const Data& data);
+
+  bool flush_offline();
+
+  void start_reconnect();
+
+  void stop_reconnect();
+
+  void onReconnect();
 
  private:
   static const argument default_arguments_;
@@ -91,6 +181,21 @@ class stream_connector : public template_connector
 
   // caching for reconnection
   argument last_arguments_ = {};
+
+  // io_uring (connector_backend == backend::io_uring)
+  std::unique_ptr<Uring> uring_ = nullptr;
+
+  // asynchronous reconnect (reconnect_async)
+  std::future<void>       reconnect_worker_ = {};
+  std::atomic_bool        reconnect_stop_   = true;
+  std::mutex              reconnect_mutex_  = {};
+  std::condition_variable reconnect_cv_     = {};
+
+  // offline buffer (연결이 끊어진 동안의 send() 데이터)
+  mutable std::mutex               offline_mutex_   = {};
+  std::deque<std::vector<uint8_t>> offline_queue_   = {};
+  size_t                           offline_size_    = 0;
+  std::atomic<uint64_t>            offline_dropped_ = { 0 };
 };
 
 };  // namespace network
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <rowen/core/transport/packet_gather.hpp>
+#include <rowen/core/transport/packet_receiver.hpp>
+#include <rowen/core/transport/packet_typedef.hpp>
+#include <rowen/network/connector_stream.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace rs {
+namespace network {
+
+/**
+ * @brief Pool of warm stream_connector with pipelined request / response
+ * @details 요청 패킷마다 request id (Packet::Header::Data::request_id)를 부여하고, 같은 request id의 응답 패킷을 future로 전달한다.
+ *          한 connection에서 응답을 기다리지 않고 여러 요청을 연속으로 보낼 수 있다 (pipelining).
+ *          서버는 응답 패킷의 request id를 요청 패킷과 같게 설정해야 한다 (Packet::updateRequestId).
+ *          요청은 연결된 connection 중 응답 대기 중인 요청이 가장 적은 connection으로 전송된다.
+ *          request id는 요청 패킷에 직접 기록되므로, 같은 패킷 객체를 여러 thread에서 동시에 request() 하면 안된다.
+ */
+class stream_connector_pool
+{
+ public:
+  struct argument
+  {
+    int connections = 4;  // warm connections
+
+    int recv_buffer_size = 65536;  // receive buffer of each connection
+
+    float reconnect_interval = 0.1;  // timeout is seconds (끊어진 connection의 재접속 간격)
+
+    float request_timeout = 0;  // timeout is seconds (응답 대기 만료, <= 0 : 만료 없음. request()의 timeout이 우선한다)
+
+    stream_connector::argument connector = {};  // argument of each connection
+  };
+
+  // response packet (연결이 끊어지거나 전송에 실패하면 rs::exception)
+  using Response = std::future<rs::Packet>;
+
+ public:
+  stream_connector_pool()                                        = default;
+  stream_connector_pool(const stream_connector_pool&)            = delete;
+  stream_connector_pool& operator=(const stream_connector_pool&) = delete;
+  ~stream_connector_pool();
+
+ public:
+  /**
+   * @brief Connect warm connections to server
+   * @param server_address : server address
+   * @param server_port : server port
+   * @param argument : pool argument
+   * @return true if at least one connection is connected
+   */
+  bool connect(const std::string& server_address,
+               const int          server_port,
+               const argument&    arguments = default_arguments_);
+
+  /**
+   * @brief Disconnect every connection (pending requests are failed)
+   */
+  void disconnect();
+
+  /**
+   * @brief Send request packet (request id of packet is overwritten)
+   * @details 전송이 끝날 때까지 packet을 다른 thread의 request()와 공유하지 않아야 한다 (request id가 바뀐다)
+   * @param timeout : timeout is seconds (<= 0 : argument::request_timeout). 만료된 요청은 receive thread가 "receive timeout"으로 실패시킨다
+   * @return response of request
+   */
+  Response request(const rs::Packet& packet, int send_flags = -1, float timeout = 0);
+
+  /**
+   * @brief Send request gather packet (request id of packet is overwritten, payload is not copied)
+   * @param timeout : timeout is seconds (<= 0 : argument::request_timeout)
+   * @return response of request
+   */
+  Response request(const rs::PacketGather& packet, int send_flags = -1, float timeout = 0);
+
+  /**
+   * @brief Send request and wait response
+   * @param timeout : timeout is seconds (<= 0 : infinite). timeout이 지나면 응답 대기를 취소한다 (이후 도착한 응답은 버린다)
+   * @return true if response is received
+   */
+  bool sendToRecv(const rs::Packet& packet, rs::Packet& response, float timeout = 0, int send_flags = -1);
+
+ public:
+  size_t connections() const;
+  size_t pending() const;
+
+  /**
+   * @brief get error message
+   * @return error message (호출한 thread에서 다음 error() 호출 전까지 유효)
+   */
+  const char* error() const;
+
+ private:
+  struct Request
+  {
+    std::promise<rs::Packet>              promise  = {};
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+  };
+
+  struct Channel
+  {
+    int index = 0;
+
+    stream_connector connector = {};
+    PacketReceiver   receiver  = {};  // receive thread only
+
+    // send_mutex : 전송, 재접속 (요청 thread와 receive thread가 동시에 재접속하지 않도록)
+    // mutex : 응답 대기 중인 요청
+    std::mutex                            send_mutex = {};
+    std::mutex                            mutex      = {};
+    std::unordered_map<uint32_t, Request> requests   = {};
+    std::atomic<size_t>                   inflight   = { 0 };
+
+    std::future<void> worker = {};
+  };
+
+  template <typename Data>
+  Response send_request(const Data& packet, int send_flags, float timeout, Channel** sent_channel = nullptr, uint32_t* sent_request_id = nullptr);
+
+  void cancel_request(Channel& channel, uint32_t request_id);
+
+  Channel* select_channel();
+
+  uint32_t next_request_id();
+
+  void onReceiveMessage(Channel* channel);
+
+  void fail_requests(Channel& channel, const std::string& reason);
+
+  void expire_requests(Channel& channel);
+
+  // 요청 thread에서 동시에 호출할 수 있다
+  void set_error(const std::string& error);
+
+ private:
+  static const argument default_arguments_;
+
+ private:
+  std::string        error_       = "";  // guarded by error_mutex_
+  mutable std::mutex error_mutex_ = {};
+
+  std::string server_address_ = "";
+  int         server_port_    = 0;
+  argument    arguments_      = {};
+
+  std::vector<std::unique_ptr<Channel>> channels_   = {};
+  std::atomic_bool                      stop_       = true;
+  std::atomic<uint32_t>                 request_id_ = { 0 };
+  std::atomic<size_t>                   round_      = { 0 };
+};
+
+};  // namespace network
+};  // namespace rs
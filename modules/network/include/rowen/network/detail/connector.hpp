@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <rowen/network/detail/socket.hpp>
 #include <string>
 
@@ -22,7 +23,13 @@ class template_connector
    * @brief get socket address
    * @return socket address
    */
-  const char* address() const { return server_ipv4_.c_str(); }
+  const char* address() const { return server_address_.c_str(); }
+
+  /**
+   * @brief get resolved server address (connect(), initialize()에서 한 번만 해석한다)
+   * @return resolved server address
+   */
+  const Endpoint& endpoint() const { return server_endpoint_; }
 
   /**
    * @brief get socket port
@@ -32,16 +39,35 @@ class template_connector
 
   /**
    * @brief get error message
-   * @return error message
+   * @return error message (호출한 thread에서 다음 error() 호출 전까지 유효)
    */
-  const char* error() const { return error_.empty() ? nullptr : error_.c_str(); }
+  const char* error() const;
 
  protected:
-  std::string error_ = "";
+  /**
+   * @brief set error message (재접속 thread, 전송 thread에서 동시에 호출할 수 있다)
+   */
+  void set_error(const std::string& error);
+
+  /**
+   * @brief set server address (주소가 바뀐 경우에만 다시 해석한다)
+   */
+  void set_server(const std::string& server_address, int server_port);
+
+  /**
+   * @brief resolve server address (이미 해석된 주소는 그대로 사용한다. 실패하면 rs::exception)
+   * @return resolved server address
+   */
+  const Endpoint& resolve_server(int socket_type);
+
+ protected:
+  std::string        error_       = "";  // guarded by error_mutex_
+  mutable std::mutex error_mutex_ = {};
 
   // server information
-  int         server_port_ = 0;
-  std::string server_ipv4_ = "";
+  int         server_port_     = 0;
+  std::string server_address_  = "";  // IPv4, IPv6 address or host name
+  Endpoint    server_endpoint_ = {};  // resolved server_address_ (재접속은 다시 해석하지 않는다)
 
   // connector socket
   class Socket socket_ = {};
@@ -58,5 +84,40 @@ inline template_connector::~template_connector()
   socket_.close();
 }
 
+inline const char* template_connector::error() const
+{
+  thread_local std::string error;
+
+  {
+    std::lock_guard<std::mutex> locker(error_mutex_);
+    error = error_;
+  }
+
+  return error.empty() ? nullptr : error.c_str();
+}
+
+inline void template_connector::set_error(const std::string& error)
+{
+  std::lock_guard<std::mutex> locker(error_mutex_);
+  error_ = error;
+}
+
+inline void template_connector::set_server(const std::string& server_address, int server_port)
+{
+  if (server_address != server_address_ || server_port != server_port_)
+    server_endpoint_ = {};
+
+  server_address_ = server_address;
+  server_port_    = server_port;
+}
+
+inline const Endpoint& template_connector::resolve_server(int socket_type)
+{
+  if (server_endpoint_.valid() == false)
+    server_endpoint_ = Endpoint::resolve(server_address_, server_port_, socket_type);
+
+  return server_endpoint_;
+}
+
 };  // namespace network
 };  // namespace rs
@@ -28,18 +28,25 @@ class template_listener
    * @brief get listener port number
    * @return port number
    */
-  int port() const { return socket_.address().sin_port; }
+  int port() const { return socket_.port(); }
 
   /**
    * @brief get last error message
-   * @return error message
+   * @return error message (호출한 thread에서 다음 error() 호출 전까지 유효)
    */
-  const char* error() const { return error_.empty() ? nullptr : error_.c_str(); }
+  const char* error() const;
 
  protected:
-  std::string  error_         = "";
-  class Socket socket_        = {};  // listener socket
-  std::mutex   listener_lock_ = {};
+  /**
+   * @brief set last error message (reactor, 전송 thread에서 동시에 호출할 수 있다)
+   */
+  void set_error(const std::string& error);
+
+ protected:
+  std::string        error_         = "";  // guarded by error_mutex_
+  mutable std::mutex error_mutex_   = {};
+  class Socket       socket_        = {};  // listener socket
+  std::mutex         listener_lock_ = {};
 
   // listener
   std::future<void> receiver_;
@@ -57,6 +64,24 @@ inline template_listener::~template_listener()
   stop();
 }
 
+inline const char* template_listener::error() const
+{
+  thread_local std::string error;
+
+  {
+    std::lock_guard<std::mutex> locker(error_mutex_);
+    error = error_;
+  }
+
+  return error.empty() ? nullptr : error.c_str();
+}
+
+inline void template_listener::set_error(const std::string& error)
+{
+  std::lock_guard<std::mutex> locker(error_mutex_);
+  error_ = error;
+}
+
 inline void template_listener::stop()
 {
   std::lock_guard<std::mutex> locker(listener_lock_);
@@ -1,12 +1,23 @@
 #pragma once
 
 #include <arpa/inet.h>
+#include <linux/errqueue.h>
+#include <netdb.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netinet/udp.h>
+#include <poll.h>
 #include <string.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <rowen/core/exception.hpp>
+#include <rowen/core/transport/packet_gather.hpp>
 #include <rowen/core/transport/packet_typedef.hpp>
 #include <string>
 
@@ -15,18 +26,78 @@ namespace network {
 
 static constexpr int INVALID_SOCKET           = -1;
 static constexpr int INVALID_PORT             = -1;
-static constexpr int DEFAULT_SEND_BUFFER_SIZE = 1024;
+static constexpr int DEFAULT_SEND_BUFFER_SIZE = 0;  // 0 : 나누지 않고 한 번에 전송
 static constexpr int DEFAULT_SEND_FLAG        = 0;
 static constexpr int DEFAULT_RECV_BUFFER_SIZE = 8192;
 static constexpr int DEFAULT_RECV_FLAG        = 0;
+static constexpr int MAX_SEND_IOVEC           = 16;
+static constexpr int MAX_UDP_PAYLOAD_SIZE     = 65507;  // IPv4 UDP datagram payload
+static constexpr int MAX_UDP_SEGMENTS         = 64;     // UDP GSO segments per send
+static constexpr int ZEROCOPY_MIN_SIZE        = 16384;  // 이보다 작은 데이터는 zero copy 대신 복사 전송 (page pinning 비용)
+
+/**
+ * @brief Resolved socket address (IPv4, IPv6)
+ * @details 주소 문자열 (numeric address, host name)은 resolve()에서 한 번만 해석한다.
+ *          재접속은 저장된 sockaddr를 그대로 사용한다 (inet_pton, DNS 조회 없음)
+ */
+struct Endpoint
+{
+  sockaddr_storage address = {};
+  socklen_t        size    = 0;
+
+  bool                   valid() const { return size > 0; }
+  int                    family() const { return address.ss_family; }
+  const struct sockaddr* data() const { return reinterpret_cast<const struct sockaddr*>(&address); }
+
+  std::string ip() const;
+  int         port() const;
+
+  /**
+   * @brief resolve address (throws rs::exception if address can not be resolved)
+   * @param host : IPv4, IPv6 address or host name (IPv4 우선)
+   * @param port : port number
+   * @param socket_type : SOCK_STREAM, SOCK_DGRAM
+   */
+  static Endpoint resolve(const std::string& host, int port, int socket_type = SOCK_STREAM);
+};
+
+/**
+ * @brief TCP socket options which are applied on accept / connect (-1, 0 : kernel default)
+ */
+struct TcpProfile
+{
+  const char* name = "default";
+
+  int no_delay     = -1;  // TCP_NODELAY (1 : Nagle 알고리즘 끔)
+  int quick_ack    = -1;  // TCP_QUICKACK (1 : delayed ack 끔. kernel이 delayed ack 모드로 되돌릴 수 있다)
+  int send_buffer  = 0;   // SO_SNDBUF (bytes. 설정하면 kernel autotuning이 꺼진다)
+  int recv_buffer  = 0;   // SO_RCVBUF (bytes)
+  int busy_poll    = 0;   // SO_BUSY_POLL (microsec. net.core.busy_read보다 크게 설정하려면 CAP_NET_ADMIN 필요, 권한이 없으면 무시된다)
+  int user_timeout = 0;   // TCP_USER_TIMEOUT (millisec. 전송한 데이터가 이 시간 동안 ack 되지 않으면 연결을 끊는다)
+
+  // 제어 메시지 (작은 요청 / 응답) : 지연 최소화
+  // (SO_BUSY_POLL은 CAP_NET_ADMIN이 필요할 수 있어 켜지 않는다. 필요하면 busy_poll을 직접 설정)
+  static TcpProfile latency() { return { "latency", 1, 1, 0, 0, 0, 5000 }; }
+
+  // 대용량 전송 (video frame 등) : 큰 socket 버퍼, Nagle 유지
+  static TcpProfile throughput() { return { "throughput", 0, 0, 4 << 20, 4 << 20, 0, 30000 }; }
+};
 
 class Socket
 {
+ public:
+  // zero copy 전송이 끝나 kernel이 더 이상 data 버퍼를 참조하지 않을 때 호출된다 (copied : kernel이 복사로 전송함)
+  using ZeroCopyRelease = std::function<void(bool copied)>;
+
  public:
   // 소멸자에서 close()를 호출하려면, 각 listener에 Socket인스턴스를 포인터로 가지고 있어야 한다.
   // ~Socket() { close(); }
 
-  bool open(int socket_type, int protocol = 0);
+  /*
+  * @brief open socket
+  * @param family : AF_INET, AF_INET6 (IPv6 only), AF_UNSPEC (dual-stack : IPv6 socket이 IPv4도 처리한다. IPv6를 지원하지 않으면 IPv4)
+  */
+  bool open(int socket_type, int protocol = 0, int family = AF_INET);
 
   void close();
 
@@ -40,8 +111,20 @@ class Socket
 
   class Socket accept();
 
+  /*
+  * @brief wrap connection which is accepted outside of accept() (e.g. io_uring multishot accept)
+  * @param accepted_handle : accepted socket handle
+  * @return accepted socket (peer address is read by getpeername)
+  */
+  class Socket accepted(int accepted_handle) const;
+
   bool connect(const std::string& ip_address, int port) const;
 
+  /*
+  * @brief connect to resolved address (address family must be same as socket)
+  */
+  bool connect(const Endpoint& endpoint) const;
+
   /*
   * @brief send data
   * @param data : data buffer
@@ -67,6 +150,26 @@ class Socket
   ssize_t send(const rs::Packet& packet, int flags = -1,
                const struct sockaddr* address = nullptr, socklen_t addr_len = -1) const;
 
+  /*
+  * @brief send scattered data at once (sendmsg)
+  * @param iov : data buffers
+  * @param iov_count : number of data buffers (up to MAX_SEND_IOVEC)
+  * @param flags : socket flags
+  * @param address : receiver address (IF socket is based on SOCK_DGRAM, otherwise nullptr)
+  * @param addr_len : receiver address length (IF socket is based on SOCK_DGRAM, otherwise -1)
+  * @return sent data size (same as send())
+  */
+  ssize_t send(const struct iovec* iov, int iov_count, int flags = -1,
+               const struct sockaddr* address = nullptr, socklen_t addr_len = -1) const;
+
+  /*
+  * @brief send gather packet (header, payload, trailer) with single sendmsg
+  * @param packet : gather packet (payload is not copied)
+  * @return sent data size (same as send())
+  */
+  ssize_t send(const rs::PacketGather& packet, int flags = -1,
+               const struct sockaddr* address = nullptr, socklen_t addr_len = -1) const;
+
   /*
   * @brief receive data
   * @param data : data buffer
@@ -80,15 +183,92 @@ class Socket
   ssize_t recv(void* data, size_t size, int flags = -1,
                struct sockaddr* address = nullptr, socklen_t* addr_len = nullptr) const;
 
+  /*
+  * @brief send data split into segment_size datagrams by kernel (UDP_SEGMENT, a.k.a. UDP GSO)
+  * @details 한 번의 sendmsg로 최대 MAX_UDP_SEGMENTS 개의 datagram (super buffer)을 전송한다.
+  *          수신측에는 segment_size 크기의 datagram으로 나뉘어 도착한다 (마지막 datagram은 더 작을 수 있다).
+  * @param segment_size : datagram size (0 or size <= segment_size : same as send())
+  * @param sent_size : 실패하기 전까지 전송된 크기 (실패 시 errno는 sendmsg의 errno. EIO : 경로가 GSO를 지원하지 않음)
+  * @return sent data size, -1 if error
+  */
+  ssize_t sendSegments(const uint8_t* data, size_t size, uint16_t segment_size, int flags = -1,
+                       const struct sockaddr* address = nullptr, socklen_t addr_len = -1, size_t* sent_size = nullptr) const;
+
+  /*
+  * @brief send datagrams at once (sendmmsg, SOCK_DGRAM only)
+  * @param messages : datagrams (msg_hdr with destination address and iovec)
+  * @param count : number of datagrams
+  * @param flags : socket flags
+  * @return number of sent datagrams (msg_len is updated), -1 if error
+  */
+  int sendBatch(struct mmsghdr* messages, unsigned int count, int flags = -1) const;
+
+  /*
+  * @brief receive datagrams at once (recvmmsg, SOCK_DGRAM only)
+  * @param messages : receive buffers (msg_hdr with address and iovec)
+  * @param count : number of receive buffers
+  * @param flags : socket flags
+  * @return number of received datagrams (msg_len is updated), 0 if no datagram is ready (EAGAIN), -1 if error
+  */
+  int recvBatch(struct mmsghdr* messages, unsigned int count, int flags = -1) const;
+
+  /*
+  * @brief enable zero copy send (SO_ZEROCOPY, SOCK_STREAM)
+  * @return false if kernel does not support zero copy
+  */
+  bool setZeroCopy(bool enable) const;
+
+  /*
+  * @brief send data without copying it to kernel (MSG_ZEROCOPY)
+  * @details data는 release가 호출될 때까지 수정하거나 해제하면 안 된다.
+  *          kernel의 전송 완료 통지는 socket error queue로 전달되며, completeZeroCopy()가 읽어서 release를 호출한다.
+  *          zero copy가 설정되지 않았거나 size < ZEROCOPY_MIN_SIZE 이면 send()로 복사 전송하고 release를 바로 호출한다.
+  * @param release : data 버퍼를 돌려받는 callback (nullptr : 통지만 처리)
+  * @return sent data size (same as send())
+  */
+  ssize_t sendZeroCopy(const uint8_t* data, size_t size, const ZeroCopyRelease& release, int flags = -1) const;
+
+  ssize_t sendZeroCopy(const rs::Packet& packet, const ZeroCopyRelease& release, int flags = -1) const;
+
+  /*
+  * @brief read zero copy completions from socket error queue and call release of completed sends
+  * @param timeout : timeout is seconds (0 : 대기하지 않음). 완료를 기다리는 전송이 없으면 대기하지 않는다
+  * @return number of released sends, -1 if error
+  */
+  int completeZeroCopy(float timeout = 0) const;
+
+  /*
+  * @brief apply TCP profile (SOCK_STREAM)
+  * @details 실패한 option이 있어도 나머지 option은 설정한다 (실패한 option은 kernel 기본값 유지)
+  * @return false if any option is failed (check reason using error())
+  */
+  bool applyTcpProfile(const TcpProfile& profile) const;
+
+  /*
+  * @brief get effective TCP options from kernel (getsockopt)
+  * @details SO_SNDBUF, SO_RCVBUF는 kernel이 관리용 공간을 포함해 설정값의 2배로 보고한다
+  * @return effective profile (name : "effective")
+  */
+  TcpProfile tcpProfile() const;
+
   bool setOption(int level, int option, const void* value, socklen_t size) const;
+  bool getOption(int level, int option, void* value, socklen_t* size) const;
 
  public:
   // getter
-  int         id() const { return handle_; }
-  sockaddr_in address() const { return sockaddr_; }
-  size_t      address_size() const { return sizeof(sockaddr_); }
-  int         type() const { return props_.socket_type; }
-  int         protocol() const { return props_.protocol; }
+  int                     id() const { return handle_; }
+  const sockaddr_storage& address() const { return sockaddr_; }  // bind : local address, accept : peer address
+  socklen_t               address_size() const { return sockaddr_size_; }
+  int                     type() const { return props_.socket_type; }
+  int                     protocol() const { return props_.protocol; }
+  int                     family() const { return props_.family; }
+
+  std::string ipaddress() const;  // numeric address of address() (IPv4-mapped IPv6 address는 IPv4로 표시)
+  int         port() const;       // port of address()
+
+  bool     zeroCopy() const { return props_.send.zerocopy; }
+  size_t   zeroCopyPending() const { return zerocopy_ ? zerocopy_->pending.size() : 0; }
+  uint64_t zeroCopyCopied() const { return zerocopy_ ? zerocopy_->copied : 0; }  // kernel이 복사로 전송한 zero copy 전송 수
 
   std::string error() const { return error_message_; }
   const char* cerror() const { return error_message_.c_str(); }
@@ -101,8 +281,9 @@ class Socket
   void setReceiveFlags(int flags) const;
 
  private:
-  int         handle_   = INVALID_SOCKET;
-  sockaddr_in sockaddr_ = {};
+  int              handle_        = INVALID_SOCKET;
+  sockaddr_storage sockaddr_      = {};
+  socklen_t        sockaddr_size_ = 0;
 
   mutable std::string error_message_ = "";
 
@@ -110,8 +291,9 @@ class Socket
   struct property
   {
     // common
-    int socket_type = 0;  // SOCK_STREAM, SOCK_DGRAM, ...
-    int protocol    = 0;  // IPPROTO_TCP,  IPPROTO_UDP, ...
+    int socket_type = 0;        // SOCK_STREAM, SOCK_DGRAM, ...
+    int protocol    = 0;        // IPPROTO_TCP,  IPPROTO_UDP, ...
+    int family      = AF_INET;  // AF_INET, AF_INET6
     int backlog     = 0;  // listen backlog
 
     // send
@@ -120,6 +302,7 @@ class Socket
       timeval timeout     = { 0, 500 };
       int     buffer_size = DEFAULT_SEND_BUFFER_SIZE;
       int     base_flags  = DEFAULT_SEND_FLAG;
+      bool    zerocopy    = false;  // SO_ZEROCOPY
     } mutable send;
 
     // recv
@@ -129,6 +312,16 @@ class Socket
       int     base_flags = DEFAULT_RECV_FLAG;
     } mutable recv;
   } props_;
+
+  // zero copy 전송 상태 (kernel 통지 id, 완료를 기다리는 전송)
+  struct zerocopy_state
+  {
+    uint32_t                                         next_id = 0;  // 다음 MSG_ZEROCOPY 전송의 kernel 통지 id
+    uint64_t                                         copied  = 0;
+    std::deque<std::pair<uint32_t, ZeroCopyRelease>> pending = {};  // (마지막 통지 id, release)
+  };
+
+  mutable std::shared_ptr<zerocopy_state> zerocopy_ = nullptr;
 };
 
 /*
@@ -148,6 +341,12 @@ inline void assert_ipv4(const std::string& address)
     throw rs::exception("invalid ipv4 address: " + address);
 }
 
+inline bool verify_ip(const std::string& address)
+{
+  struct in6_addr sa6;
+  return verify_ipv4(address) || inet_pton(AF_INET6, address.c_str(), &sa6) == 1;
+}
+
 inline bool verify_port(const int port)
 {
   return port >= 0 && port < 65536;  // 0: 고헤드
@@ -167,21 +366,147 @@ inline struct timeval float_to_timeval(const float sec)
   return timeout;
 }
 
-inline bool Socket::open(int socket_type, int protocol)
+// numeric address (IPv4-mapped IPv6 address는 IPv4로 표시)
+inline std::string address_to_string(const struct sockaddr* address)
+{
+  char buffer[INET6_ADDRSTRLEN] = {};
+
+  if (address == nullptr)
+    return "";
+
+  if (address->sa_family == AF_INET)
+  {
+    inet_ntop(AF_INET, &reinterpret_cast<const struct sockaddr_in*>(address)->sin_addr, buffer, sizeof(buffer));
+  }
+  else if (address->sa_family == AF_INET6)
+  {
+    auto address6 = reinterpret_cast<const struct sockaddr_in6*>(address);
+
+    if (IN6_IS_ADDR_V4MAPPED(&address6->sin6_addr))
+      inet_ntop(AF_INET, &address6->sin6_addr.s6_addr[12], buffer, sizeof(buffer));
+    else
+      inet_ntop(AF_INET6, &address6->sin6_addr, buffer, sizeof(buffer));
+  }
+
+  return buffer;
+}
+
+inline int address_to_port(const struct sockaddr* address)
+{
+  if (address == nullptr)
+    return INVALID_PORT;
+
+  if (address->sa_family == AF_INET)
+    return ntohs(reinterpret_cast<const struct sockaddr_in*>(address)->sin_port);
+
+  if (address->sa_family == AF_INET6)
+    return ntohs(reinterpret_cast<const struct sockaddr_in6*>(address)->sin6_port);
+
+  return INVALID_PORT;
+}
+
+inline std::string Endpoint::ip() const
+{
+  return address_to_string(data());
+}
+
+inline int Endpoint::port() const
+{
+  return address_to_port(data());
+}
+
+inline Endpoint Endpoint::resolve(const std::string& host, int port, int socket_type)
+{
+  assert_port(port);
+
+  Endpoint endpoint;
+
+  // numeric address는 DNS 조회 없이 변환한다
+  auto address4 = reinterpret_cast<struct sockaddr_in*>(&endpoint.address);
+  auto address6 = reinterpret_cast<struct sockaddr_in6*>(&endpoint.address);
+
+  if (inet_pton(AF_INET, host.c_str(), &address4->sin_addr) == 1)
+  {
+    address4->sin_family = AF_INET;
+    address4->sin_port   = htons(port);
+    endpoint.size        = sizeof(struct sockaddr_in);
+    return endpoint;
+  }
+
+  if (inet_pton(AF_INET6, host.c_str(), &address6->sin6_addr) == 1)
+  {
+    address6->sin6_family = AF_INET6;
+    address6->sin6_port   = htons(port);
+    endpoint.size         = sizeof(struct sockaddr_in6);
+    return endpoint;
+  }
+
+  // host name
+  struct addrinfo hints = {};
+  hints.ai_family       = AF_UNSPEC;
+  hints.ai_socktype     = socket_type;
+  hints.ai_flags        = AI_ADDRCONFIG | AI_NUMERICSERV;
+
+  struct addrinfo* result = nullptr;
+
+  int res = ::getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &result);
+  if (res != 0 || result == nullptr)
+    throw rs::exception("resolve " + host + " : " + std::string(res != 0 ? ::gai_strerror(res) : "no address"));
+
+  // IPv4 주소를 우선한다 (IPv6만 있는 host는 IPv6)
+  const struct addrinfo* selected = result;
+  for (auto info = result; info != nullptr; info = info->ai_next)
+  {
+    if (info->ai_family == AF_INET)
+    {
+      selected = info;
+      break;
+    }
+  }
+
+  ::memcpy(&endpoint.address, selected->ai_addr, selected->ai_addrlen);
+  endpoint.size = selected->ai_addrlen;
+
+  ::freeaddrinfo(result);
+
+  return endpoint;
+}
+
+inline bool Socket::open(int socket_type, int protocol, int family)
 {
   close();
 
   props_.socket_type = socket_type;
   props_.protocol    = protocol;
+  props_.family      = family == AF_UNSPEC ? AF_INET6 : family;
+
+  handle_ = ::socket(props_.family, socket_type, protocol);
 
-  handle_ = ::socket(AF_INET, socket_type, protocol);
+  // dual-stack : IPv6를 지원하지 않는 host는 IPv4
+  if (handle_ < 0 && family == AF_UNSPEC && (errno == EAFNOSUPPORT || errno == EPROTONOSUPPORT))
+  {
+    props_.family = AF_INET;
+    handle_       = ::socket(props_.family, socket_type, protocol);
+  }
 
-  if (handle_ <= 0)
+  if (handle_ < 0)
   {
+    handle_        = INVALID_SOCKET;
     error_message_ = ::strerror(errno);
     return false;
   }
 
+  // AF_INET6 : IPv6 only, AF_UNSPEC : IPv4-mapped IPv6 address로 IPv4도 처리한다
+  if (props_.family == AF_INET6)
+  {
+    int v6_only = family == AF_INET6 ? 1 : 0;
+    if (setOption(IPPROTO_IPV6, IPV6_V6ONLY, &v6_only, sizeof(v6_only)) == false)
+    {
+      close();
+      return false;
+    }
+  }
+
   return true;
 }
 
@@ -195,6 +520,18 @@ inline void Socket::close()
     handle_ = INVALID_SOCKET;
     error_message_.clear();
   }
+
+  // 완료 통지를 받지 못한 zero copy 전송은 버퍼를 돌려준다
+  if (zerocopy_)
+  {
+    auto state = std::move(zerocopy_);
+
+    props_.send.zerocopy = false;
+
+    for (auto& [id, release] : state->pending)
+      if (release)
+        release(true);
+  }
 }
 
 inline bool Socket::shutdown(int how) const
@@ -221,16 +558,36 @@ inline bool Socket::bind(int port)
   if (verify_port(port) == false)
     return false;
 
-  sockaddr_.sin_family      = AF_INET;
-  sockaddr_.sin_addr.s_addr = htonl(INADDR_ANY);
-  sockaddr_.sin_port        = htons(port);
+  sockaddr_ = {};
+
+  if (props_.family == AF_INET6)
+  {
+    auto address         = reinterpret_cast<struct sockaddr_in6*>(&sockaddr_);
+    address->sin6_family = AF_INET6;
+    address->sin6_addr   = in6addr_any;
+    address->sin6_port   = htons(port);
+    sockaddr_size_       = sizeof(struct sockaddr_in6);
+  }
+  else
+  {
+    auto address             = reinterpret_cast<struct sockaddr_in*>(&sockaddr_);
+    address->sin_family      = AF_INET;
+    address->sin_addr.s_addr = htonl(INADDR_ANY);
+    address->sin_port        = htons(port);
+    sockaddr_size_           = sizeof(struct sockaddr_in);
+  }
 
-  if (::bind(handle_, (struct sockaddr*)&sockaddr_, sizeof(sockaddr_)) == -1)
+  if (::bind(handle_, (struct sockaddr*)&sockaddr_, sockaddr_size_) == -1)
   {
     error_message_ = ::strerror(errno);
     return false;
   }
 
+  // port 0 : kernel이 할당한 port
+  socklen_t address_size = sizeof(sockaddr_);
+  if (port == 0 && ::getsockname(handle_, (struct sockaddr*)&sockaddr_, &address_size) == 0)
+    sockaddr_size_ = address_size;
+
   return true;
 }
 
@@ -255,8 +612,8 @@ inline bool Socket::listen(int backlog)
 
 inline class Socket Socket::accept()
 {
-  struct sockaddr_in accepted_addr      = {};
-  socklen_t          accepted_addr_size = sizeof(sockaddr_);
+  struct sockaddr_storage accepted_addr      = {};
+  socklen_t               accepted_addr_size = sizeof(accepted_addr);
 
   auto accepted_handle = ::accept(handle_, (struct sockaddr*)&accepted_addr, &accepted_addr_size);
 
@@ -265,32 +622,46 @@ inline class Socket Socket::accept()
     error_message_ = ::strerror(errno);
     return Socket();
   }
-  else
-  {
-    class Socket accepted_socket;
-    socklen_t    type_len   = sizeof(accepted_socket.props_.socket_type);
-    accepted_socket.handle_ = accepted_handle;
-    accepted_socket.props_  = props_;
 
-    if (getsockopt(accepted_handle, SOL_SOCKET, SO_TYPE, &accepted_socket.props_.socket_type, &type_len) == -1)
-      accepted_socket.props_.socket_type = props_.socket_type;
+  auto accepted_socket = accepted(accepted_handle);
+  memcpy(&accepted_socket.sockaddr_, &accepted_addr, accepted_addr_size);
+  accepted_socket.sockaddr_size_ = accepted_addr_size;
+  return accepted_socket;
+}
+
+inline class Socket Socket::accepted(int accepted_handle) const
+{
+  class Socket accepted_socket;
+  socklen_t    type_len   = sizeof(accepted_socket.props_.socket_type);
+  accepted_socket.handle_ = accepted_handle;
+  accepted_socket.props_  = props_;
+
+  if (getsockopt(accepted_handle, SOL_SOCKET, SO_TYPE, &accepted_socket.props_.socket_type, &type_len) == -1)
+    accepted_socket.props_.socket_type = props_.socket_type;
 
-    memcpy(&accepted_socket.sockaddr_, &accepted_addr, accepted_addr_size);
-    return accepted_socket;
+  // zero copy는 socket마다 설정한다
+  accepted_socket.props_.send.zerocopy = false;
+
+  socklen_t address_size = sizeof(accepted_socket.sockaddr_);
+  if (getpeername(accepted_handle, (struct sockaddr*)&accepted_socket.sockaddr_, &address_size) == -1)
+  {
+    accepted_socket.sockaddr_ = {};
+    address_size              = 0;
   }
+
+  accepted_socket.sockaddr_size_ = address_size;
+
+  return accepted_socket;
 }
 
 inline bool Socket::connect(const std::string& ip_address, int port) const
 {
-  assert_ipv4(ip_address);
-  assert_port(port);
-
-  sockaddr_in address = {};
-  address.sin_family  = AF_INET;
-  address.sin_port    = htons(port);
-  inet_pton(AF_INET, ip_address.c_str(), &address.sin_addr);
+  return connect(Endpoint::resolve(ip_address, port, props_.socket_type));
+}
 
-  if (::connect(handle_, (struct sockaddr*)&address, sizeof(address)) == -1)
+inline bool Socket::connect(const Endpoint& endpoint) const
+{
+  if (::connect(handle_, endpoint.data(), endpoint.size) == -1)
   {
     error_message_ = ::strerror(errno);
     return false;
@@ -299,6 +670,16 @@ inline bool Socket::connect(const std::string& ip_address, int port) const
   return true;
 }
 
+inline std::string Socket::ipaddress() const
+{
+  return address_to_string(reinterpret_cast<const struct sockaddr*>(&sockaddr_));
+}
+
+inline int Socket::port() const
+{
+  return address_to_port(reinterpret_cast<const struct sockaddr*>(&sockaddr_));
+}
+
 inline ssize_t Socket::send(const uint8_t* data, size_t size, int flags, const struct sockaddr* address, socklen_t addr_len) const
 {
   constexpr int MAX_RETRY = 3;
@@ -325,10 +706,11 @@ inline ssize_t Socket::send(const uint8_t* data, size_t size, int flags, const s
 
     while (true)
     {
-      int remain_size = size - total_send_size;
-      int buffer_size = std::min(remain_size, props_.send.buffer_size);
+      // send buffer size가 0 이하면 남은 데이터를 한 번에 전송한다
+      size_t remain_size = size - total_send_size;
+      size_t buffer_size = props_.send.buffer_size > 0 ? std::min(remain_size, static_cast<size_t>(props_.send.buffer_size)) : remain_size;
 
-      if (buffer_size <= 0)
+      if (buffer_size == 0)
         break;
 
       ssize_t send_size = 0;
@@ -398,6 +780,129 @@ inline ssize_t Socket::send(const rs::Packet& packet, int flags, const struct so
   return send(packet.data(), packet.size(), flags, address, addr_len);
 }
 
+inline ssize_t Socket::send(const struct iovec* iov, int iov_count, int flags, const struct sockaddr* address, socklen_t addr_len) const
+{
+  constexpr int MAX_RETRY = 3;
+
+  ssize_t total_send_size = 0;
+
+  try
+  {
+    if (this->valid() == false)
+      throw rs::exception("invalid socket handle");
+
+    if (iov == nullptr || iov_count <= 0 || iov_count > MAX_SEND_IOVEC)
+      throw rs::exception("invalid data buffer");
+
+    if (this->type() == SOCK_DGRAM && (address == nullptr || addr_len <= 0))
+      throw rs::exception("invalid address");
+
+    // 부분 전송 시 남은 영역을 가리키도록 복사해서 사용한다
+    struct iovec vectors[MAX_SEND_IOVEC];
+    size_t       size = 0;
+
+    for (int i = 0; i < iov_count; ++i)
+    {
+      vectors[i] = iov[i];
+      size += iov[i].iov_len;
+    }
+
+    if (size <= 0)
+      throw rs::exception("invalid data size");
+
+    struct msghdr message = {};
+    message.msg_iov       = vectors;
+    message.msg_iovlen    = iov_count;
+
+    if (this->type() == SOCK_DGRAM)
+    {
+      message.msg_name    = const_cast<struct sockaddr*>(address);
+      message.msg_namelen = addr_len;
+    }
+
+    // --- send data -------------------------------------------------------------
+    int flag  = flags < 0 ? props_.send.base_flags : flags;
+    int retry = 0;
+
+    while (total_send_size < static_cast<ssize_t>(size))
+    {
+      ssize_t send_size = ::sendmsg(handle_, &message, flag);
+
+      // --- error handling ------------------------------------------------------
+      if (send_size > 0)
+      {
+        retry = 0;
+        total_send_size += send_size;
+
+        // skip sent buffers
+        while (message.msg_iovlen > 0 && static_cast<size_t>(send_size) >= message.msg_iov->iov_len)
+        {
+          send_size -= message.msg_iov->iov_len;
+          message.msg_iov++;
+          message.msg_iovlen--;
+        }
+
+        if (message.msg_iovlen > 0)
+        {
+          message.msg_iov->iov_base = static_cast<uint8_t*>(message.msg_iov->iov_base) + send_size;
+          message.msg_iov->iov_len -= send_size;
+        }
+      }
+      else
+      {
+        if (++retry >= MAX_RETRY)
+          break;
+      }
+    }
+
+    // --- error handling --------------------------------------------------------
+    if (total_send_size != static_cast<ssize_t>(size))
+    {
+      // 재접속이 필요한 경우와 관련된 에러 코드
+      if (errno == EPIPE ||
+          errno == ECONNABORTED ||
+          errno == ECONNREFUSED ||
+          errno == ETIMEDOUT ||
+          errno == ENETRESET ||
+          errno == ECONNRESET ||
+          errno == ENOTCONN ||
+          errno == ENETDOWN ||
+          errno == EHOSTDOWN ||
+          errno == EHOSTUNREACH)
+      {
+        total_send_size = 0;
+      }
+      else
+      {
+        total_send_size = -1;  // 사용자 측에서 에러 처리를 위해 초기화
+      }
+
+      throw rs::exception(::strerror(errno));
+    }
+  }
+  catch (const rs::exception& e)
+  {
+    error_message_ = e.what();
+  }
+
+  return total_send_size;
+}
+
+inline ssize_t Socket::send(const rs::PacketGather& packet, int flags, const struct sockaddr* address, socklen_t addr_len) const
+{
+  struct iovec iov[3];
+  int          iov_count = 0;
+
+  for (const auto& segment : packet.segments())
+  {
+    iov[iov_count].iov_base = const_cast<uint8_t*>(segment.data);
+    iov[iov_count].iov_len  = segment.size;
+    iov_count++;
+  }
+
+  return send(iov, iov_count, flags, address, addr_len);
+}
+
 inline ssize_t Socket::recv(void* data, size_t size, int flags, struct sockaddr* address, socklen_t* addr_len) const
 {
   ssize_t read_size = 0;
@@ -459,6 +964,423 @@ inline ssize_t Socket::recv(void* data, size_t size, int flags, struct sockaddr*
   return read_size;
 }
 
+inline ssize_t Socket::sendSegments(const uint8_t* data, size_t size, uint16_t segment_size, int flags, const struct sockaddr* address, socklen_t addr_len, size_t* sent_size) const
+{
+  if (segment_size == 0 || size <= segment_size)
+    return send(data, size, flags, address, addr_len);
+
+  ssize_t total_send_size = 0;
+  int     send_error      = 0;
+
+  if (sent_size != nullptr)
+    *sent_size = 0;
+
+  try
+  {
+    if (this->valid() == false)
+      throw rs::exception("invalid socket handle");
+
+    if (this->type() != SOCK_DGRAM)
+      throw rs::exception("segment send is only for SOCK_DGRAM");
+
+    if (data == nullptr)
+      throw rs::exception("invalid data buffer");
+
+    if (address == nullptr || addr_len <= 0)
+      throw rs::exception("invalid address");
+
+    if (segment_size > MAX_UDP_PAYLOAD_SIZE)
+      throw rs::exception("invalid segment size");
+
+    // super buffer : segment_size 단위로 나누어 떨어지는 최대 크기
+    const size_t super_size = std::min<size_t>(MAX_UDP_SEGMENTS, MAX_UDP_PAYLOAD_SIZE / segment_size) * segment_size;
+
+    char control[CMSG_SPACE(sizeof(uint16_t))] = {};
+
+    struct iovec  vector  = {};
+    struct msghdr message = {};
+    message.msg_iov       = &vector;
+    message.msg_iovlen    = 1;
+    message.msg_name      = const_cast<struct sockaddr*>(address);
+    message.msg_namelen   = addr_len;
+
+    // --- send data -------------------------------------------------------------
+    int flag = flags < 0 ? props_.send.base_flags : flags;
+
+    while (total_send_size < static_cast<ssize_t>(size))
+    {
+      vector.iov_base = const_cast<uint8_t*>(data) + total_send_size;
+      vector.iov_len  = std::min(super_size, size - total_send_size);
+
+      // segment size는 매 전송마다 control message로 지정한다
+      message.msg_control    = control;
+      message.msg_controllen = sizeof(control);
+
+      struct cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+      cmsg->cmsg_level     = SOL_UDP;
+      cmsg->cmsg_type      = UDP_SEGMENT;
+      cmsg->cmsg_len       = CMSG_LEN(sizeof(uint16_t));
+      ::memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(uint16_t));
+
+      ssize_t send_size = ::sendmsg(handle_, &message, flag);
+      if (send_size <= 0)
+        break;
+
+      total_send_size += send_size;
+    }
+
+    if (sent_size != nullptr)
+      *sent_size = total_send_size;
+
+    // --- error handling --------------------------------------------------------
+    if (total_send_size != static_cast<ssize_t>(size))
+    {
+      send_error      = errno;
+      total_send_size = -1;
+      throw rs::exception(::strerror(send_error));
+    }
+  }
+  catch (const rs::exception& e)
+  {
+    error_message_ = e.what();
+  }
+
+  // 호출한 쪽에서 원인 (e.g. EIO)을 확인할 수 있도록 한다
+  if (send_error != 0)
+    errno = send_error;
+
+  return total_send_size;
+}
+
+inline int Socket::sendBatch(struct mmsghdr* messages, unsigned int count, int flags) const
+{
+  int sent_count = 0;
+
+  try
+  {
+    if (this->valid() == false)
+      throw rs::exception("invalid socket handle");
+
+    if (this->type() != SOCK_DGRAM)
+      throw rs::exception("batch send is only for SOCK_DGRAM");
+
+    if (messages == nullptr || count == 0)
+      throw rs::exception("invalid data buffer");
+
+    // --- send data -------------------------------------------------------------
+    int flag = flags < 0 ? props_.send.base_flags : flags;
+
+    // sendmmsg는 일부만 전송하고 반환할 수 있으므로 남은 datagram을 이어서 전송한다
+    while (sent_count < static_cast<int>(count))
+    {
+      int res = ::sendmmsg(handle_, messages + sent_count, count - sent_count, flag);
+      if (res <= 0)
+        break;
+
+      sent_count += res;
+    }
+
+    // --- error handling --------------------------------------------------------
+    if (sent_count == 0)
+    {
+      sent_count = -1;
+      throw rs::exception(::strerror(errno));
+    }
+  }
+  catch (const rs::exception& e)
+  {
+    error_message_ = e.what();
+  }
+
+  return sent_count;
+}
+
+inline int Socket::recvBatch(struct mmsghdr* messages, unsigned int count, int flags) const
+{
+  int recv_count = -1;
+
+  try
+  {
+    if (this->valid() == false)
+      throw rs::exception("invalid socket handle");
+
+    if (this->type() != SOCK_DGRAM)
+      throw rs::exception("batch receive is only for SOCK_DGRAM");
+
+    if (messages == nullptr || count == 0)
+      throw rs::exception("invalid data buffer");
+
+    // --- receive data ----------------------------------------------------------
+    int flag = flags < 0 ? props_.recv.base_flags : flags;
+
+    recv_count = ::recvmmsg(handle_, messages, count, flag, nullptr);
+
+    // --- error handling --------------------------------------------------------
+    if (recv_count < 0)
+    {
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+        recv_count = 0;
+      else
+        throw rs::exception(::strerror(errno));
+    }
+  }
+  catch (const rs::exception& e)
+  {
+    error_message_ = e.what();
+  }
+
+  return recv_count;
+}
+
+inline bool Socket::setZeroCopy(bool enable) const
+{
+  if (this->type() != SOCK_STREAM)
+  {
+    error_message_ = "zero copy is only for SOCK_STREAM";
+    return false;
+  }
+
+  int value = enable ? 1 : 0;
+  if (setOption(SOL_SOCKET, SO_ZEROCOPY, &value, sizeof(value)) == false)
+    return false;
+
+  props_.send.zerocopy = enable;
+
+  if (enable && zerocopy_ == nullptr)
+    zerocopy_ = std::make_shared<zerocopy_state>();
+
+  return true;
+}
+
+inline ssize_t Socket::sendZeroCopy(const uint8_t* data, size_t size, const ZeroCopyRelease& release, int flags) const
+{
+  // 복사 전송
+  if (props_.send.zerocopy == false || size < static_cast<size_t>(ZEROCOPY_MIN_SIZE))
+  {
+    ssize_t res = send(data, size, flags);
+
+    if (release)
+      release(true);
+
+    return res;
+  }
+
+  constexpr int MAX_RETRY = 3;
+
+  ssize_t total_send_size = 0;
+  bool    referenced      = false;  // kernel이 data 버퍼를 참조 (MSG_ZEROCOPY 전송 성공)
+
+  try
+  {
+    if (this->valid() == false)
+      throw rs::exception("invalid socket handle");
+
+    if (data == nullptr)
+      throw rs::exception("invalid data buffer");
+
+    // --- send data -------------------------------------------------------------
+    int flag  = (flags < 0 ? props_.send.base_flags : flags) | MSG_ZEROCOPY;
+    int retry = 0;
+
+    while (total_send_size < static_cast<ssize_t>(size))
+    {
+      size_t remain_size = size - total_send_size;
+      size_t buffer_size = props_.send.buffer_size > 0 ? std::min(remain_size, static_cast<size_t>(props_.send.buffer_size)) : remain_size;
+
+      // 성공한 MSG_ZEROCOPY 전송마다 kernel 통지 id가 하나씩 증가한다
+      ssize_t send_size = ::send(handle_, data + total_send_size, buffer_size, flag);
+      if (send_size > 0)
+      {
+        retry = 0;
+        total_send_size += send_size;
+        zerocopy_->next_id++;
+        referenced = true;
+        continue;
+      }
+
+      // 고정(pinned)된 page가 한도(optmem)를 넘음 : 완료 통지를 처리하고 다시 전송한다
+      if (send_size < 0 && errno == ENOBUFS)
+        completeZeroCopy(0.01);
+
+      if (++retry >= MAX_RETRY)
+        break;
+    }
+
+    // --- error handling --------------------------------------------------------
+    if (total_send_size != static_cast<ssize_t>(size))
+    {
+      // 재접속이 필요한 경우와 관련된 에러 코드
+      if (errno == EPIPE ||
+          errno == ECONNABORTED ||
+          errno == ECONNREFUSED ||
+          errno == ETIMEDOUT ||
+          errno == ENETRESET ||
+          errno == ECONNRESET ||
+          errno == ENOTCONN ||
+          errno == ENETDOWN ||
+          errno == EHOSTDOWN ||
+          errno == EHOSTUNREACH)
+      {
+        total_send_size = 0;
+      }
+      else
+      {
+        total_send_size = -1;
+      }
+
+      throw rs::exception(::strerror(errno));
+    }
+  }
+  catch (const rs::exception& e)
+  {
+    error_message_ = e.what();
+  }
+
+  // 마지막 전송의 완료 통지를 받으면 release 한다
+  if (referenced)
+    zerocopy_->pending.emplace_back(zerocopy_->next_id - 1, release);
+  else if (release)
+    release(true);
+
+  return total_send_size;
+}
+
+inline ssize_t Socket::sendZeroCopy(const rs::Packet& packet, const ZeroCopyRelease& release, int flags) const
+{
+  return sendZeroCopy(packet.data(), packet.size(), release, flags);
+}
+
+inline int Socket::completeZeroCopy(float timeout) const
+{
+  int released = 0;
+
+  try
+  {
+    if (this->valid() == false)
+      throw rs::exception("invalid socket handle");
+
+    if (zerocopy_ == nullptr || zerocopy_->pending.empty())
+      return 0;
+
+    // error queue는 POLLERR로 통지된다
+    if (timeout > 0)
+    {
+      struct pollfd descriptor = { handle_, 0, 0 };
+      ::poll(&descriptor, 1, static_cast<int>(timeout * 1000));
+    }
+
+    while (zerocopy_ && zerocopy_->pending.empty() == false)
+    {
+      char control[128];
+
+      struct msghdr message  = {};
+      message.msg_control    = control;
+      message.msg_controllen = sizeof(control);
+
+      if (::recvmsg(handle_, &message, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+      {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+          break;
+
+        throw rs::exception(::strerror(errno));
+      }
+
+      for (auto cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr; cmsg = CMSG_NXTHDR(&message, cmsg))
+      {
+        if ((cmsg->cmsg_level != SOL_IP || cmsg->cmsg_type != IP_RECVERR) &&
+            (cmsg->cmsg_level != SOL_IPV6 || cmsg->cmsg_type != IPV6_RECVERR))
+          continue;
+
+        auto error = reinterpret_cast<const struct sock_extended_err*>(CMSG_DATA(cmsg));
+        if (error->ee_errno != 0 || error->ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+          continue;
+
+        // [ee_info, ee_data] 범위의 전송이 완료됨 (TCP는 전송 순서대로 완료된다)
+        const uint32_t last   = error->ee_data;
+        const bool     copied = (error->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0;
+
+        if (copied)
+          zerocopy_->copied += last - error->ee_info + 1;
+
+        while (zerocopy_ && zerocopy_->pending.empty() == false && static_cast<int32_t>(last - zerocopy_->pending.front().first) >= 0)
+        {
+          auto release = std::move(zerocopy_->pending.front().second);
+          zerocopy_->pending.pop_front();
+          released++;
+
+          if (release)
+            release(copied);
+        }
+      }
+    }
+  }
+  catch (const rs::exception& e)
+  {
+    error_message_ = e.what();
+    return -1;
+  }
+
+  return released;
+}
+
+inline bool Socket::applyTcpProfile(const TcpProfile& profile) const
+{
+  if (this->valid() == false)
+  {
+    error_message_ = "invalid socket handle";
+    return false;
+  }
+
+  std::string failed = "";
+
+  auto apply = [&](bool enabled, int level, int option, int value, const char* option_name) {
+    if (enabled == false || setOption(level, option, &value, sizeof(value)))
+      return;
+
+    // net.core.busy_read보다 큰 SO_BUSY_POLL은 CAP_NET_ADMIN이 필요하다 (권한이 없으면 적용하지 않고 넘어간다)
+    if (option == SO_BUSY_POLL && errno == EPERM)
+      return;
+
+    failed += std::string(failed.empty() ? "" : ", ") + option_name + " : " + error_message_;
+  };
+
+  apply(profile.no_delay >= 0, IPPROTO_TCP, TCP_NODELAY, profile.no_delay, "TCP_NODELAY");
+  apply(profile.quick_ack >= 0, IPPROTO_TCP, TCP_QUICKACK, profile.quick_ack, "TCP_QUICKACK");
+  apply(profile.send_buffer > 0, SOL_SOCKET, SO_SNDBUF, profile.send_buffer, "SO_SNDBUF");
+  apply(profile.recv_buffer > 0, SOL_SOCKET, SO_RCVBUF, profile.recv_buffer, "SO_RCVBUF");
+  apply(profile.busy_poll > 0, SOL_SOCKET, SO_BUSY_POLL, profile.busy_poll, "SO_BUSY_POLL");
+  apply(profile.user_timeout > 0, IPPROTO_TCP, TCP_USER_TIMEOUT, profile.user_timeout, "TCP_USER_TIMEOUT");
+
+  if (failed.empty() == false)
+  {
+    error_message_ = failed;
+    return false;
+  }
+
+  return true;
+}
+
+inline TcpProfile Socket::tcpProfile() const
+{
+  TcpProfile profile = {};
+  profile.name       = "effective";
+
+  auto read = [&](int level, int option, int& value) {
+    socklen_t size = sizeof(value);
+    if (getOption(level, option, &value, &size) == false)
+      value = -1;
+  };
+
+  read(IPPROTO_TCP, TCP_NODELAY, profile.no_delay);
+  read(IPPROTO_TCP, TCP_QUICKACK, profile.quick_ack);
+  read(SOL_SOCKET, SO_SNDBUF, profile.send_buffer);
+  read(SOL_SOCKET, SO_RCVBUF, profile.recv_buffer);
+  read(SOL_SOCKET, SO_BUSY_POLL, profile.busy_poll);
+  read(IPPROTO_TCP, TCP_USER_TIMEOUT, profile.user_timeout);
+
+  return profile;
+}
+
 inline bool Socket::setOption(int level, int option, const void* value, socklen_t size) const
 {
   if (::setsockopt(handle_, level, option, value, size) == -1)
@@ -470,6 +1392,17 @@ inline bool Socket::setOption(int level, int option, const void* value, socklen_
   return true;
 }
 
+inline bool Socket::getOption(int level, int option, void* value, socklen_t* size) const
+{
+  if (::getsockopt(handle_, level, option, value, size) == -1)
+  {
+    error_message_ = ::strerror(errno);
+    return false;
+  }
+
+  return true;
+}
+
 inline bool Socket::setSendTimeout(const float sec) const
 {
   struct timeval timeout = float_to_timeval(sec);
@@ -483,10 +1416,8 @@ inline bool Socket::setSendTimeout(const float sec) const
 
 inline void Socket::setSendBufferSize(int size) const
 {
-  if (size > 0)
-    props_.send.buffer_size = size;
-  else
-    props_.send.buffer_size = DEFAULT_SEND_BUFFER_SIZE;
+  // 0 이하 : 나누지 않고 전송
+  props_.send.buffer_size = size > 0 ? size : 0;
 }
 
 inline void Socket::setSendFlags(int flags) const
@@ -0,0 +1,480 @@
+#pragma once
+
+#include <linux/io_uring.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <memory>
+
+namespace rs {
+namespace network {
+
+/**
+ * @brief io_uring instance (raw syscall. liburing 미사용)
+ * @details submission queue는 한 thread에서만 사용해야 한다 (lock 없음).
+ *          provided buffer ring은 하나의 buffer group만 등록할 수 있다.
+ */
+class Uring
+{
+ public:
+  Uring()                        = default;
+  Uring(const Uring&)            = delete;
+  Uring& operator=(const Uring&) = delete;
+  ~Uring() { close(); }
+
+  /**
+   * @brief Check kernel supports io_uring features used by rs::network
+   * @details multishot accept/recv, provided buffer ring, IORING_ENTER_EXT_ARG (linux 6.0 이상).
+   *          io_uring이 비활성화된 경우(kernel.io_uring_disabled, seccomp)에도 false를 반환한다.
+   */
+  static bool supported();
+
+  bool open(unsigned entries);
+  void close();
+  bool valid() const { return handle_ >= 0; }
+  int  id() const { return handle_; }
+
+ public:
+  /**
+   * @brief Register provided buffer ring (count : power of 2)
+   */
+  bool registerBuffers(uint16_t group, unsigned count, unsigned size);
+
+  uint16_t       bufferGroup() const { return buffer_group_; }
+  const uint8_t* buffer(uint16_t buffer_id) const { return buffers_.get() + static_cast<size_t>(buffer_id) * buffer_size_; }
+
+  /**
+   * @brief Return buffer to provided buffer ring
+   */
+  void recycle(uint16_t buffer_id);
+
+ public:
+  /**
+   * @brief Get empty submission entry
+   * @return nullptr if submission queue is full
+   */
+  struct io_uring_sqe* sqe();
+
+  // prepare submission entry (return false if submission queue is full)
+  bool prepareAccept(int fd, uint64_t user_data, bool multishot);
+  bool prepareRecv(int fd, uint64_t user_data, int flags, bool multishot);
+  bool prepareSend(int fd, const void* data, size_t size, uint64_t user_data, int flags, bool link);
+  bool preparePoll(int fd, uint32_t events, uint64_t user_data, bool multishot);
+  bool prepareCancel(int fd, uint64_t user_data);                  // cancel all requests of fd
+  bool prepareCancelRequest(uint64_t target, uint64_t user_data);  // cancel request of user_data (target)
+
+  /**
+   * @brief Submit prepared entries and wait completion
+   * @param wait_nr : number of completion to wait
+   * @param timeout_ms : wait timeout (negative : infinite)
+   * @return number of submitted entries, otherwise -errno (-ETIME : timeout)
+   */
+  int submit(unsigned wait_nr = 0, int timeout_ms = -1);
+
+  /**
+   * @brief Consume completion entries
+   * @param function : function(const io_uring_cqe&)
+   * @return number of consumed entries
+   */
+  template <typename Function>
+  unsigned drain(Function&& function);
+
+ private:
+  static int setup(unsigned entries, struct io_uring_params* params);
+  static int enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags, const void* arg, size_t size);
+  static int registers(int fd, unsigned opcode, const void* arg, unsigned nr_args);
+
+ private:
+  int handle_ = -1;
+
+  // ring memory
+  void*  sq_ring_      = nullptr;
+  size_t sq_ring_size_ = 0;
+  void*  cq_ring_      = nullptr;
+  size_t cq_ring_size_ = 0;
+  void*  sqes_         = nullptr;
+  size_t sqes_size_    = 0;
+
+  // submission queue
+  unsigned*            sq_head_  = nullptr;
+  unsigned*            sq_tail_  = nullptr;
+  unsigned*            sq_array_ = nullptr;
+  unsigned             sq_mask_  = 0;
+  unsigned             sq_count_ = 0;
+  unsigned             sq_local_ = 0;  // 작성 중인 tail (submit()에서 공개)
+  struct io_uring_sqe* sq_entry_ = nullptr;
+
+  // completion queue
+  unsigned*            cq_head_  = nullptr;
+  unsigned*            cq_tail_  = nullptr;
+  unsigned             cq_mask_  = 0;
+  struct io_uring_cqe* cq_entry_ = nullptr;
+
+  // provided buffer ring
+  struct io_uring_buf_ring*  buffer_ring_      = nullptr;
+  size_t                     buffer_ring_size_ = 0;
+  std::unique_ptr<uint8_t[]> buffers_          = nullptr;
+  unsigned                   buffer_count_     = 0;
+  unsigned                   buffer_size_      = 0;
+  uint16_t                   buffer_group_     = 0;
+  uint16_t                   buffer_tail_      = 0;
+};
+
+/*
+----------------------------------------------------------------------------------
+  Implementation
+----------------------------------------------------------------------------------
+*/
+
+inline int Uring::setup(unsigned entries, struct io_uring_params* params)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+inline int Uring::enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags, const void* arg, size_t size)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, arg, size));
+}
+
+inline int Uring::registers(int fd, unsigned opcode, const void* arg, unsigned nr_args)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+inline bool Uring::supported()
+{
+  static const bool result = [] {
+    Uring ring;
+    if (ring.open(8) == false)
+      return false;
+
+    // opcode probe (IORING_OP_SEND_ZC는 multishot recv와 같은 6.0에 추가되었다)
+    constexpr unsigned OPCODE_COUNT = 256;
+
+    auto probe_size = sizeof(struct io_uring_probe) + OPCODE_COUNT * sizeof(struct io_uring_probe_op);
+    auto probe      = std::make_unique<uint8_t[]>(probe_size);
+    auto info       = reinterpret_cast<struct io_uring_probe*>(probe.get());
+
+    if (registers(ring.id(), IORING_REGISTER_PROBE, info, OPCODE_COUNT) < 0)
+      return false;
+
+    for (auto opcode : { IORING_OP_ACCEPT, IORING_OP_RECV, IORING_OP_SEND, IORING_OP_POLL_ADD, IORING_OP_ASYNC_CANCEL, IORING_OP_SEND_ZC })
+      if (opcode > info->last_op || (info->ops[opcode].flags & IO_URING_OP_SUPPORTED) == 0)
+        return false;
+
+    return ring.registerBuffers(0, 2, 64);
+  }();
+
+  return result;
+}
+
+inline bool Uring::open(unsigned entries)
+{
+  close();
+
+  // multishot 수신은 submission 보다 많은 completion을 만든다
+  struct io_uring_params params = {};
+  params.flags                  = IORING_SETUP_CQSIZE | IORING_SETUP_COOP_TASKRUN;
+  params.cq_entries             = std::max(entries, 1u) * 4;
+
+  handle_ = setup(std::max(entries, 1u), &params);
+  if (handle_ < 0 && errno == EINVAL)
+  {
+    params            = {};
+    params.flags      = IORING_SETUP_CQSIZE;
+    params.cq_entries = std::max(entries, 1u) * 4;
+    handle_           = setup(std::max(entries, 1u), &params);
+  }
+
+  if (handle_ < 0)
+  {
+    handle_ = -1;
+    return false;
+  }
+
+  // IORING_ENTER_EXT_ARG (wait timeout) 필요
+  if ((params.features & IORING_FEAT_EXT_ARG) == 0 || (params.features & IORING_FEAT_SINGLE_MMAP) == 0)
+  {
+    close();
+    return false;
+  }
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  sqes_size_    = params.sq_entries * sizeof(struct io_uring_sqe);
+
+  sq_ring_ = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, handle_, IORING_OFF_SQ_RING);
+  sqes_    = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, handle_, IORING_OFF_SQES);
+  cq_ring_ = sq_ring_;  // IORING_FEAT_SINGLE_MMAP
+
+  if (sq_ring_ == MAP_FAILED || sqes_ == MAP_FAILED)
+  {
+    if (sq_ring_ == MAP_FAILED)
+      sq_ring_ = nullptr;
+    if (sqes_ == MAP_FAILED)
+      sqes_ = nullptr;
+    close();
+    return false;
+  }
+
+  auto sq = static_cast<uint8_t*>(sq_ring_);
+  auto cq = static_cast<uint8_t*>(cq_ring_);
+
+  sq_head_  = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  sq_tail_  = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+  sq_mask_  = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  sq_count_ = params.sq_entries;
+  sq_local_ = *sq_tail_;
+  sq_entry_ = static_cast<struct io_uring_sqe*>(sqes_);
+
+  cq_head_  = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  cq_tail_  = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  cq_mask_  = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  cq_entry_ = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+  return true;
+}
+
+inline void Uring::close()
+{
+  // ring을 닫으면 kernel이 진행 중인 요청을 모두 취소한다 (buffer는 그 이후에 해제)
+  if (handle_ >= 0)
+    ::close(handle_);
+  handle_ = -1;
+
+  if (sq_ring_ != nullptr)
+    ::munmap(sq_ring_, sq_ring_size_);
+  if (sqes_ != nullptr)
+    ::munmap(sqes_, sqes_size_);
+  if (buffer_ring_ != nullptr)
+    ::munmap(buffer_ring_, buffer_ring_size_);
+
+  sq_ring_      = nullptr;
+  cq_ring_      = nullptr;
+  sqes_         = nullptr;
+  buffer_ring_  = nullptr;
+  buffers_      = nullptr;
+  buffer_count_ = 0;
+}
+
+inline bool Uring::registerBuffers(uint16_t group, unsigned count, unsigned size)
+{
+  if (valid() == false || buffer_ring_ != nullptr || count == 0 || count > 32768 || (count & (count - 1)) != 0 || size == 0)
+    return false;
+
+  // ring은 page 정렬이 필요하다
+  buffer_ring_size_ = count * sizeof(struct io_uring_buf);
+
+  void* ring = ::mmap(nullptr, buffer_ring_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (ring == MAP_FAILED)
+    return false;
+
+  struct io_uring_buf_reg reg = {};
+  reg.ring_addr               = reinterpret_cast<uint64_t>(ring);
+  reg.ring_entries            = count;
+  reg.bgid                    = group;
+
+  if (registers(handle_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+  {
+    ::munmap(ring, buffer_ring_size_);
+    return false;
+  }
+
+  buffer_ring_  = static_cast<struct io_uring_buf_ring*>(ring);
+  buffers_      = std::make_unique<uint8_t[]>(static_cast<size_t>(count) * size);
+  buffer_count_ = count;
+  buffer_size_  = size;
+  buffer_group_ = group;
+  buffer_tail_  = 0;
+
+  for (unsigned buffer_id = 0; buffer_id < count; ++buffer_id)
+    recycle(static_cast<uint16_t>(buffer_id));
+
+  return true;
+}
+
+inline void Uring::recycle(uint16_t buffer_id)
+{
+  // C++에서는 __DECLARE_FLEX_ARRAY(bufs)의 빈 구조체가 크기를 가지므로 ring 시작 주소에서 직접 계산한다
+  auto& entry = reinterpret_cast<struct io_uring_buf*>(buffer_ring_)[buffer_tail_ & (buffer_count_ - 1)];
+  entry.addr  = reinterpret_cast<uint64_t>(buffer(buffer_id));
+  entry.len   = buffer_size_;
+  entry.bid   = buffer_id;
+
+  __atomic_store_n(&buffer_ring_->tail, ++buffer_tail_, __ATOMIC_RELEASE);
+}
+
+inline struct io_uring_sqe* Uring::sqe()
+{
+  if (valid() == false)
+    return nullptr;
+
+  // 가득 찼다면 먼저 제출한다
+  if (sq_local_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_count_)
+  {
+    submit();
+    if (sq_local_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_count_)
+      return nullptr;
+  }
+
+  auto index       = sq_local_ & sq_mask_;
+  auto entry       = &sq_entry_[index];
+  sq_array_[index] = index;
+  sq_local_++;
+
+  ::memset(entry, 0, sizeof(*entry));
+  return entry;
+}
+
+inline bool Uring::prepareAccept(int fd, uint64_t user_data, bool multishot)
+{
+  auto entry = sqe();
+  if (entry == nullptr)
+    return false;
+
+  entry->opcode       = IORING_OP_ACCEPT;
+  entry->fd           = fd;
+  entry->accept_flags = SOCK_CLOEXEC;
+  entry->ioprio       = multishot ? IORING_ACCEPT_MULTISHOT : 0;
+  entry->user_data    = user_data;
+  return true;
+}
+
+inline bool Uring::prepareRecv(int fd, uint64_t user_data, int flags, bool multishot)
+{
+  auto entry = sqe();
+  if (entry == nullptr)
+    return false;
+
+  // 수신 버퍼는 provided buffer ring에서 kernel이 선택한다
+  entry->opcode    = IORING_OP_RECV;
+  entry->fd        = fd;
+  entry->msg_flags = static_cast<uint32_t>(flags);
+  entry->flags     = IOSQE_BUFFER_SELECT;
+  entry->buf_group = buffer_group_;
+  entry->ioprio    = multishot ? IORING_RECV_MULTISHOT : 0;
+  entry->user_data = user_data;
+  return true;
+}
+
+inline bool Uring::prepareSend(int fd, const void* data, size_t size, uint64_t user_data, int flags, bool link)
+{
+  auto entry = sqe();
+  if (entry == nullptr)
+    return false;
+
+  entry->opcode    = IORING_OP_SEND;
+  entry->fd        = fd;
+  entry->addr      = reinterpret_cast<uint64_t>(data);
+  entry->len       = static_cast<uint32_t>(size);
+  entry->msg_flags = static_cast<uint32_t>(flags);
+  entry->flags     = link ? IOSQE_IO_LINK : 0;
+  entry->user_data = user_data;
+  return true;
+}
+
+inline bool Uring::preparePoll(int fd, uint32_t events, uint64_t user_data, bool multishot)
+{
+  auto entry = sqe();
+  if (entry == nullptr)
+    return false;
+
+  entry->opcode        = IORING_OP_POLL_ADD;
+  entry->fd            = fd;
+  entry->poll32_events = events;
+  entry->len           = multishot ? IORING_POLL_ADD_MULTI : 0;
+  entry->user_data     = user_data;
+  return true;
+}
+
+inline bool Uring::prepareCancelRequest(uint64_t target, uint64_t user_data)
+{
+  auto entry = sqe();
+  if (entry == nullptr)
+    return false;
+
+  entry->opcode    = IORING_OP_ASYNC_CANCEL;
+  entry->fd        = -1;
+  entry->addr      = target;
+  entry->user_data = user_data;
+  return true;
+}
+
+inline bool Uring::prepareCancel(int fd, uint64_t user_data)
+{
+  auto entry = sqe();
+  if (entry == nullptr)
+    return false;
+
+  entry->opcode       = IORING_OP_ASYNC_CANCEL;
+  entry->fd           = fd;
+  entry->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+  entry->user_data    = user_data;
+  return true;
+}
+
+inline int Uring::submit(unsigned wait_nr, int timeout_ms)
+{
+  if (valid() == false)
+    return -EBADF;
+
+  __atomic_store_n(sq_tail_, sq_local_, __ATOMIC_RELEASE);
+
+  unsigned to_submit = sq_local_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  unsigned flags     = wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0;
+
+  struct __kernel_timespec      timeout = {};
+  struct io_uring_getevents_arg arg     = {};
+
+  if (wait_nr > 0 && timeout_ms >= 0)
+  {
+    timeout.tv_sec  = timeout_ms / 1000;
+    timeout.tv_nsec = (timeout_ms % 1000) * 1000000L;
+
+    arg.sigmask_sz = _NSIG / 8;
+    arg.ts         = reinterpret_cast<uint64_t>(&timeout);
+
+    flags |= IORING_ENTER_EXT_ARG;
+  }
+
+  if (to_submit == 0 && wait_nr == 0)
+    return 0;
+
+  int res = enter(handle_, to_submit, wait_nr, flags, (flags & IORING_ENTER_EXT_ARG) ? &arg : nullptr, sizeof(arg));
+  return res < 0 ? -errno : res;
+}
+
+template <typename Function>
+unsigned Uring::drain(Function&& function)
+{
+  unsigned head  = *cq_head_;
+  unsigned tail  = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  unsigned count = 0;
+
+  while (head != tail)
+  {
+    // function에서 새 요청을 준비할 수 있도록 entry를 복사한 뒤 반환한다
+    struct io_uring_cqe cqe = cq_entry_[head & cq_mask_];
+    __atomic_store_n(cq_head_, ++head, __ATOMIC_RELEASE);
+
+    function(cqe);
+    count++;
+
+    if (head == tail)
+      tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  }
+
+  return count;
+}
+
+};  // namespace network
+};  // namespace rs
@@ -11,6 +11,7 @@ class dgram_listener : public template_listener
  public:
   struct argument
   {
+    int  socket_family   = AF_INET;  // AF_INET, AF_INET6 (IPv6 only), AF_UNSPEC : dual-stack (IPv4 peer는 IPv4-mapped sockaddr_in6로 전달된다)
     int  socket_protocol = 0;
     bool reuse_address   = true;
     bool reuse_port      = true;
@@ -22,10 +23,29 @@ class dgram_listener : public template_listener
     float listener_send_timeout     = 1;  // timeout is seconds
     int   listener_send_flags       = MSG_NOSIGNAL;
     int   listener_send_buffer_size = DEFAULT_SEND_BUFFER_SIZE;
+
+    // batch receive (recvmmsg) : 미리 할당한 buffer ring에 여러 datagram을 한 번에 수신한다
+    // 0 : datagram마다 recv()를 호출한다
+    int listener_recv_batch_size = 0;
+
+    // UDP GRO : 같은 송신측의 연속된 datagram을 하나의 buffer로 합쳐서 수신한다 (segment size는 control message로 전달된다)
+    // 수신 버퍼는 최소 MAX_UDP_PAYLOAD_SIZE로 늘어나며, batch receive로 수신한다 (batch size 0 -> 1)
+    bool listener_recv_gro = false;
+  };
+
+  // received datagram (buffer is valid only in callback)
+  struct Datagram
+  {
+    const uint8_t*         data         = nullptr;
+    size_t                 size         = 0;
+    const struct sockaddr* addr         = nullptr;
+    socklen_t              addr_len     = 0;
+    size_t                 segment_size = 0;  // UDP GRO : data is coalesced segments of segment_size (0 : single datagram)
   };
 
   // callback
-  using OnReceivedCallback = std::function<void(const uint8_t*, size_t, const struct sockaddr*, const socklen_t)>;
+  using OnReceivedCallback      = std::function<void(const uint8_t*, size_t, const struct sockaddr*, const socklen_t)>;
+  using OnReceivedBatchCallback = std::function<void(const Datagram*, size_t)>;
 
  public:
   /**
@@ -50,6 +70,20 @@ class dgram_listener : public template_listener
                const socklen_t           addr_len,
                int                       send_flags = -1);
 
+  /**
+   * @brief send listener (IPv4, IPv6 destination)
+   * @param data : data buffer (with. unsigned char*)
+   * @param size : data size (byte)
+   * @param addr : destination address (e.g. address of received callback)
+   * @param addr_len : destination address length
+   * @param send_flags : send flag (default : listener argument listener_send_flags)
+   */
+  ssize_t send(const uint8_t*         data,
+               const size_t           size,
+               const struct sockaddr* addr,
+               const socklen_t        addr_len,
+               int                    send_flags = -1);
+
   /**
    * @brief send listener
    * @param packet : rs packet struct
@@ -76,14 +110,28 @@ class dgram_listener : public template_listener
    */
   void attachReceivedCallback(const OnReceivedCallback& callback);
 
+  /**
+   * @brief attach batch receive callback (listener_recv_batch_size > 0)
+   * @details batch mode에서는 recvmmsg로 수신한 datagram들을 한 번에 전달한다.
+   *          batch callback이 없으면 datagram마다 received callback을 호출한다.
+   *          UDP GRO 사용 시 batch callback은 합쳐진 buffer (segment_size)를 그대로 받고,
+   *          received callback은 segment 단위로 나누어 호출된다.
+   * @param callback : batch callback (datagrams, count)
+   */
+  void attachReceivedBatchCallback(const OnReceivedBatchCallback& callback);
+
  private:
   void onReceiveMessage(const argument& arguments);
+  void onReceiveMessageBatch(const argument& arguments);
+
+  bool wait_readable(float timeout_sec);
 
  private:
   static const argument default_arguments_;
 
  private:
-  OnReceivedCallback callback_received_ = nullptr;
+  OnReceivedCallback      callback_received_       = nullptr;
+  OnReceivedBatchCallback callback_received_batch_ = nullptr;
 };
 
 };  // namespace network
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <rowen/core/transport/packet_receiver.hpp>
 #include <rowen/core/transport/packet_typedef.hpp>
 #include <rowen/network/detail/listener.hpp>
+#include <rowen/network/detail/uring.hpp>
 #include <unordered_map>
+#include <vector>
 
 namespace rs {
 namespace network {
@@ -13,22 +18,50 @@ class stream_listener : public template_listener
  public:
   typedef struct ConnectedClient
   {
-    class Socket client_socket     = {};
-    char         client_ipaddr[16] = {};
+    class Socket client_socket                   = {};
+    char         client_ipaddr[INET6_ADDRSTRLEN] = {};  // IPv4, IPv6 (IPv4-mapped IPv6 address는 IPv4로 표시)
+    int          client_port                     = 0;
+    int          reactor                         = 0;  // client를 처리하는 reactor index
   } Client;
 
+  // event loop
+  enum class backend
+  {
+    select,  // select() (FD_SETSIZE 미만의 socket만 처리 가능)
+    epoll,     // edge-triggered epoll (persistent interest set)
+    io_uring,  // io_uring multishot accept/recv + provided buffer ring (지원하지 않는 kernel은 epoll)
+  };
+
+  // client output queue가 client_send_queue_max를 넘을 때
+  enum class queue_policy
+  {
+    drop_newest,  // 새 데이터를 버린다 (send() returns -1)
+    drop_oldest,  // 전송을 시작하지 않은 가장 오래된 데이터부터 버린다
+    disconnect,   // client 연결을 끊는다 (send() returns 0)
+  };
+
  public:
   struct argument
   {
+    backend listener_backend = backend::select;
+
+    int   socket_family           = AF_UNSPEC;  // AF_UNSPEC : dual-stack (IPv6, IPv4), AF_INET, AF_INET6 (IPv6 only)
     int   socket_protocol         = 0;
     bool  reuse_address           = true;
     bool  reuse_port              = true;
     int   backlog                 = 5;
     bool  using_rs_packet         = false;
     bool  trace_rs_packet         = false;
+    bool  verify_rs_packet        = false;  // rs packet checksum(CRC32C) 검사
     float listener_select_timeout = 1;  // timeout is seconds
     int   listener_buffer_size    = DEFAULT_RECV_BUFFER_SIZE;
     int   listener_recv_timeout   = 0;
+    int   listener_max_events     = 256;  // epoll_wait()로 한 번에 처리하는 최대 event 수 (epoll, io_uring queue 크기)
+    int   listener_uring_buffers  = 256;  // reactor마다 등록하는 수신 버퍼 수 (io_uring, 크기 : listener_buffer_size)
+
+    // reactor (epoll) : reactor마다 SO_REUSEPORT listener socket, epoll, thread를 가지며 kernel이 연결을 분배한다
+    int              listener_reactors         = 1;
+    std::vector<int> listener_reactor_affinity = {};  // reactor i의 thread를 affinity[i % size] CPU에 고정 (empty : 고정하지 않음)
 
     // for client
     int   client_recv_flags   = MSG_NOSIGNAL;
@@ -36,14 +69,34 @@ class stream_listener : public template_listener
     int   client_send_flags   = MSG_NOSIGNAL;
     float client_send_timeout = 1;  // timeout is seconds
     int   client_buffer_size  = DEFAULT_SEND_BUFFER_SIZE;
+    bool  client_send_queue   = false;  // 바로 전송하지 못한 데이터는 client output queue에 두고 event loop가 전송 (epoll, io_uring)
+
+    // accept한 client socket에 적용할 TCP option (TcpProfile::latency(), TcpProfile::throughput(), ...)
+    // 적용된 값은 client->client_socket.tcpProfile()로 확인한다
+    TcpProfile client_tcp_profile = {};
+
+    // client output queue 크기 제한 (bytes, client_send_queue)
+    // high watermark를 넘으면 backpressure callback(congested : true), low watermark 이하로 전송되면 callback(congested : false)
+    size_t       client_send_queue_high   = 1 << 20;
+    size_t       client_send_queue_low    = 256 << 10;
+    size_t       client_send_queue_max    = 16 << 20;  // 0 : 제한 없음
+    queue_policy client_send_queue_policy = queue_policy::drop_newest;
   };
 
   // callback
   using OnConnectedCallback    = std::function<void(const Client*)>;
   using OnDisconnectedCallback = std::function<void(const Client*)>;
   using OnReceivedCallback     = std::function<void(const Client*, const uint8_t*, int)>;
+  using OnBackpressureCallback = std::function<void(const Client*, bool congested, size_t queued_size)>;
 
  public:
+  ~stream_listener() override;
+
+  /**
+   * @brief stop listener
+   */
+  void stop() override;
+
   /**
    * @brief running listener
    * @param port : port number
@@ -52,8 +105,17 @@ class stream_listener : public template_listener
    */
   bool running(int port, const argument& arguments = default_arguments_);
 
+  /**
+   * @brief get backend of running listener
+   * @return backend (io_uring을 지원하지 않는 kernel은 epoll)
+   */
+  backend active_backend() const { return active_backend_; }
+
   /**
    * @brief send listener
+   * @details client_send_queue가 설정된 경우 send()는 block 되지 않는다.
+   *          한 번의 send()로 전송하지 못한 데이터는 client output queue에 복사되고, socket이 writable 해지면 event loop가 전송한다.
+   *          output queue가 client_send_queue_max를 넘으면 client_send_queue_policy에 따라 처리된다 (attachBackpressureCallback).
    * @param client : client instance (a.k.a. ConnectedClient)
    * @param data : data buffer (with. unsigned char*)
    * @param size : data size (byte)
@@ -70,6 +132,33 @@ class stream_listener : public template_listener
    */
   ssize_t send(const Client* client, const rs::Packet& packet, int send_flag = -1);
 
+  /**
+   * @brief send listener (scatter-gather. payload is not copied)
+   * @param client : client instance (a.k.a. ConnectedClient)
+   * @param packet : rs gather packet
+   * @param send_flag : send flag (default : listener argument client_send_flags)
+   */
+  ssize_t send(const Client* client, const rs::PacketGather& packet, int send_flag = -1);
+
+  /**
+   * @brief send to every connected client
+   * @details 데이터는 한 번만 복사되어 refcount 버퍼로 모든 client output queue가 공유한다 (client_send_queue).
+   *          client_send_queue가 설정되지 않은 경우 client마다 send()를 호출한다.
+   * @param data : data buffer (with. unsigned char*)
+   * @param size : data size (byte)
+   * @param send_flag : send flag (default : listener argument client_send_flags)
+   * @return number of clients which data is sent or queued
+   */
+  size_t broadcast(const uint8_t* data, int size, int send_flag = -1);
+
+  /**
+   * @brief send rs packet to every connected client
+   * @param packet : rs packet
+   * @param send_flag : send flag (default : listener argument client_send_flags)
+   * @return number of clients which packet is sent or queued
+   */
+  size_t broadcast(const rs::Packet& packet, int send_flag = -1);
+
   /**
    * @brief get connected clients
    * @return connected clients
@@ -99,8 +188,93 @@ class stream_listener : public template_listener
   void attachDisconnectedCallback(const OnDisconnectedCallback& callback);
   void attachReceivedCallback(const OnReceivedCallback& callback);
 
+  /**
+   * @brief attach backpressure callback (client_send_queue)
+   * @details output queue가 high watermark를 넘으면 congested = true, low watermark 이하가 되면 congested = false로 호출된다.
+   *          send()를 호출한 thread 또는 reactor thread에서 호출되며, callback 안에서 send()를 호출할 수 있다.
+   */
+  void attachBackpressureCallback(const OnBackpressureCallback& callback);
+
+  /**
+   * @brief Number of send() data which is dropped by output queue limit (client_send_queue_max)
+   */
+  uint64_t dropped() const { return dropped_; }
+
  private:
-  void onReceiveMessage(const argument& attr);
+  // client output queue의 송신 대기 데이터 (메시지 단위, broadcast()는 같은 버퍼를 공유한다)
+  using OutputBuffer = std::shared_ptr<const std::vector<uint8_t>>;
+
+  struct Output
+  {
+    OutputBuffer buffer = nullptr;
+    size_t       offset = 0;  // 전송된 위치
+  };
+
+  // reactor lock 밖에서 호출할 backpressure callback
+  struct Backpressure
+  {
+    const Client* client      = nullptr;
+    bool          congested   = false;
+    size_t        queued_size = 0;
+  };
+
+  // 연결된 client의 수신 상태
+  struct Session
+  {
+    const Client*                   client   = nullptr;
+    std::vector<uint8_t>            buffer   = {};       // 재사용 수신 버퍼 (select, epoll)
+    std::unique_ptr<PacketReceiver> receiver = nullptr;  // rs packet
+    PacketReceiver::Spans           packets  = {};
+
+    // 송신 대기 데이터 (client_send_queue. reactor mutex로 보호)
+    std::deque<Output> output        = {};
+    size_t             output_size   = 0;      // 전송되지 않은 크기
+    bool               writable_wait = false;  // writable event 대기 중 (EPOLLOUT, POLLOUT)
+    bool               congested     = false;  // high watermark 초과 (low watermark 이하로 전송되면 해제)
+  };
+
+  // event loop thread (listener socket, epoll, client session)
+  struct Reactor
+  {
+    int                    index         = 0;
+    class Socket*          socket        = nullptr;  // reactor 0 : template_listener::socket_
+    class Socket           listen_socket = {};       // reactor 1 ~ N-1 (SO_REUSEPORT)
+    int                    epoll_handle  = INVALID_SOCKET;
+    std::unique_ptr<Uring> uring         = nullptr;
+    int                    event_handle  = INVALID_SOCKET;  // eventfd (io_uring : 다른 thread의 writable 대기 요청)
+    std::future<void>      worker        = {};
+
+    // 연결된 client session (by. socket). 다른 reactor와 lock을 공유하지 않는다
+    std::mutex                       mutex;
+    std::unordered_map<int, Session> sessions          = {};
+    std::vector<int>                 writable_requests = {};  // io_uring : POLLOUT을 등록할 client socket
+  };
+
+  void open_reactor(Reactor& reactor, int port, const argument& args);
+  void close_reactor(Reactor& reactor);
+  void pin_reactor(const Reactor& reactor, const argument& args);
+
+  void onReceiveMessage(Reactor* reactor, const argument& attr);
+  void onReceiveMessageEpoll(Reactor* reactor, const argument& attr);
+  void onReceiveMessageUring(Reactor* reactor, const argument& attr);
+
+  const Client* accept_client(Reactor& reactor, const argument& args);
+  const Client* add_client(Reactor& reactor, class Socket accepted_socket, const argument& args);
+  bool          receive_client(Session& session, const argument& args);
+  void          deliver(Session& session, const uint8_t* data, ssize_t size, const argument& args);
+  void          remove_client(Reactor& reactor, int client_socket, const argument& args);
+
+  Reactor* reactor_of(const Client* client) const;
+
+  ssize_t send_queued(Reactor& reactor, const Client* client, const struct iovec* iov, int iov_count, int send_flag);
+  ssize_t broadcast_queued(Reactor& reactor, Session& session, const OutputBuffer& buffer, int flags, std::vector<Backpressure>& notifications);
+  void    watch_writable(Reactor& reactor, Session& session, bool enable);
+  bool    flush_client(Reactor& reactor, Session& session);
+  bool    limit_output(Session& session, size_t size);
+  bool    update_congestion(Session& session) const;
+  void    notify_backpressure(const Client* client, bool congested, size_t queued_size);
+
+  static void trace_packet(const uint8_t* data, ssize_t size);
 
  private:
   static const argument default_arguments_;
@@ -109,13 +283,19 @@ class stream_listener : public template_listener
   OnConnectedCallback    callback_connected_    = nullptr;
   OnDisconnectedCallback callback_disconnected_ = nullptr;
   OnReceivedCallback     callback_received_     = nullptr;
+  OnBackpressureCallback callback_backpressure_ = nullptr;
 
  private:
+  // 연결된 client 목록 (clients(), client() 조회용). 연결, 해제 시에만 lock을 잡는다
   mutable std::mutex              connected_clients_mutex_;
   std::unordered_map<int, Client> connected_clients_;
 
-  // rs packet
-  std::unordered_map<const Client*, std::unique_ptr<PacketReceiver>> rs_packet_receiver_;
+  // reactor (select : 1)
+  std::vector<std::unique_ptr<Reactor>> reactors_;
+  backend                               active_backend_ = backend::select;
+  argument                              arguments_      = {};  // running() argument (backend 대체 반영)
+
+  std::atomic<uint64_t> dropped_ = { 0 };  // client output queue 제한으로 버린 send() 데이터
 };
 
 };  // namespace network
@@ -1,15 +1,23 @@
 #include <arpa/inet.h>
 #include <ifaddrs.h>
+#include <linux/netlink.h>
 #include <linux/route.h>
+#include <linux/rtnetlink.h>
 #include <netinet/in.h>
+#include <poll.h>
 #include <sys/ioctl.h>
+#include <sys/socket.h>
 #include <unistd.h>
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 #include <fstream>
+#include <map>
 #include <rowen/network/config.hpp>
 #include <sstream>
+#include <stdexcept>
+#include <thread>
 
 rs::network::config rs::network::config::instance_;
 
@@ -30,272 +38,952 @@ static bool is_ethernet_interface(const std::string& interface)
   return false;
 }
 
-void config::release()
+static std::string select_interface(const config::Ethernets& interfaces)
 {
-  instance_.available_interfaces_.clear();
-  instance_.last_error_.clear();
+  if (interfaces.empty())
+    throw std::runtime_error("No available interface");
+
+  if (interfaces.size() == 1)
+    return interfaces.front();
+
+  config::Ethernets candidates;
+  for (const auto& candidate : interfaces)
+  {
+    std::string iface = candidate;
+
+    // remove ETHERNET_INTERFACES
+    for (auto remove_key : ETHERNET_INTERFACES)
+    {
+      if (iface.find(remove_key) != std::string::npos)
+      {
+        iface.erase(0, std::strlen(remove_key));
+        break;
+      }
+    }
+
+    // Parse the interface number
+    if (iface.empty() == false && std::isdigit(iface[0]))
+    {
+      std::string number = "";
+      number             = iface.substr(0, iface.find_first_not_of("0123456789"));
+
+      if (std::stoi(number) == 0)
+        candidates.push_back(candidate);
+    }
+  }
+
+  if (candidates.size() == 1)
+    return candidates.front();
+  else
+    throw std::runtime_error("Two or more `0` interfaces exist");
 }
 
-void config::configure()
+static std::string format_address(in_addr_t address)
 {
-  release();
+  char ip[INET_ADDRSTRLEN];
+  std::memset(ip, 0, sizeof(ip));
+
+  inet_ntop(AF_INET, &address, ip, INET_ADDRSTRLEN);
+  return ip;
+}
+
+static std::string format_mac(const uint8_t* address, size_t size)
+{
+  uint8_t bytes[6] = {};
+  std::memcpy(bytes, address, std::min(size, sizeof(bytes)));
+
+  char mac[18];
+  std::snprintf(mac, sizeof(mac), "%.2x:%.2x:%.2x:%.2x:%.2x:%.2x",
+                bytes[0], bytes[1], bytes[2], bytes[3], bytes[4], bytes[5]);
+  return mac;
+}
+
+// fallback : 조회마다 getifaddrs / ioctl / /proc/net/route를 읽는다 (netlink를 사용할 수 없을 때)
+static config::Ethernets query_interfaces()
+{
+  config::Ethernets interfaces;
 
   struct ifaddrs* ifaddr = nullptr;
 
-  try
+  // Query the network interfaces
+  if (getifaddrs(&ifaddr) < 0)
+    throw std::runtime_error("configure : getifaddrs : " + std::string(strerror(errno)));
+
+  // Search for Ethernet interfaces
+  for (struct ifaddrs* ifa = ifaddr; ifa != nullptr; ifa = ifa->ifa_next)
   {
-    // Query the network interfaces
-    if (getifaddrs(&ifaddr) < 0)
-      throw std::runtime_error("configure : getifaddrs : " + std::string(strerror(errno)));
+    if (ifa->ifa_addr == nullptr)
+      continue;
 
-    // Search for Ethernet interfaces
-    for (struct ifaddrs* ifa = ifaddr; ifa != nullptr; ifa = ifa->ifa_next)
-    {
-      if (ifa->ifa_addr == nullptr)
-        continue;
+    if (!is_ethernet_interface(ifa->ifa_name))
+      continue;
 
-      if (!is_ethernet_interface(ifa->ifa_name))
-        continue;
+    // Regist name (if not already registered)
+    if (std::find(interfaces.begin(), interfaces.end(), ifa->ifa_name) == interfaces.end())
+      interfaces.push_back(ifa->ifa_name);
+  }
+
+  // Free the memory allocated by getifaddrs
+  freeifaddrs(ifaddr);
+
+  return interfaces;
+}
+
+static std::string query_mac_address(const std::string& iface)
+{
+  int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0)
+    throw std::runtime_error("MacAddress : invalid socket : " + std::string(strerror(errno)));
+
+  struct ifreq ifr;
+  std::strncpy(ifr.ifr_name, iface.c_str(), IFNAMSIZ - 1);
+  if (ioctl(fd, SIOCGIFHWADDR, &ifr) < 0)
+  {
+    ::close(fd);
+    throw std::runtime_error("MacAddress : ioctl : " + std::string(strerror(errno)));
+  }
+
+  ::close(fd);
+  return format_mac(reinterpret_cast<const uint8_t*>(ifr.ifr_hwaddr.sa_data), 6);
+}
+
+static std::string query_ip_address(const std::string& iface)
+{
+  char ip[INET_ADDRSTRLEN];
+  std::memset(ip, 0, sizeof(ip));
+
+  struct ifaddrs* ifaddr = nullptr;
+  if (getifaddrs(&ifaddr) < 0)
+    throw std::runtime_error("IPAddress : getifaddrs : " + std::string(strerror(errno)));
 
-      // Regist name (if not already registered)
-      if (std::find(instance_.available_interfaces_.begin(),
-                    instance_.available_interfaces_.end(),
-                    ifa->ifa_name) == instance_.available_interfaces_.end())
+  for (struct ifaddrs* ifa = ifaddr; ifa != nullptr; ifa = ifa->ifa_next)
+  {
+    if (ifa->ifa_addr == nullptr)
+      continue;
+
+    if (std::strcmp(ifa->ifa_name, iface.c_str()) != 0)
+      continue;
+
+    if (ifa->ifa_addr->sa_family == AF_INET)
+    {
+      struct sockaddr_in* sa = (struct sockaddr_in*)ifa->ifa_addr;
+      if (inet_ntop(AF_INET, &sa->sin_addr, ip, INET_ADDRSTRLEN) == nullptr)
       {
-        instance_.available_interfaces_.push_back(ifa->ifa_name);
+        freeifaddrs(ifaddr);
+        throw std::runtime_error("IPAddress : inet_ntop : " + std::string(strerror(errno)));
       }
+      break;
     }
   }
-  catch (const std::exception& e)
+
+  freeifaddrs(ifaddr);
+  return ip;
+}
+
+static std::string query_gateway(const std::string& iface)
+{
+  std::ifstream route_file("/proc/net/route");
+  if (!route_file.is_open())
+    throw std::runtime_error("Gateway : open : /proc/net/route");
+
+  std::string line;
+  while (std::getline(route_file, line))
   {
-    instance_.last_error_ = e.what();
+    std::istringstream ss(line);
+    std::string        iface_name, destination, gateway_ip;
+
+    ss >> iface_name >> destination >> gateway_ip;
+    if (iface_name == iface && destination == "00000000")
+    {
+      unsigned long     gw;
+      std::stringstream ss_gateway;
+      ss_gateway << std::hex << gateway_ip;
+      ss_gateway >> gw;
+
+      return format_address(static_cast<in_addr_t>(gw));
+    }
   }
 
-  // Free the memory allocated by getifaddrs
-  if (ifaddr != nullptr)
+  return "";
+}
+
+static std::string query_subnet_mask(const std::string& iface)
+{
+  char subnet[INET_ADDRSTRLEN];
+  std::memset(subnet, 0, sizeof(subnet));
+
+  int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0)
+    throw std::runtime_error("Subnet : invalid socket : " + std::string(strerror(errno)));
+
+  struct ifreq ifr;
+  std::strncpy(ifr.ifr_name, iface.c_str(), IFNAMSIZ - 1);
+  if (ioctl(fd, SIOCGIFNETMASK, &ifr) < 0)
   {
-    freeifaddrs(ifaddr);
-    ifaddr = nullptr;
+    ::close(fd);
+    throw std::runtime_error("Subnet : ioctl : " + std::string(strerror(errno)));
   }
+
+  ::close(fd);
+
+  inet_ntop(AF_INET, &(((struct sockaddr_in*)&ifr.ifr_netmask)->sin_addr), subnet, INET_ADDRSTRLEN);
+  return subnet;
 }
 
-config::Ethernets config::InterfaceList()
+// snapshot을 읽는 동안 readers_를 유지한다
+struct snapshot_reader
 {
-  return instance_.available_interfaces_;
-}
+  explicit snapshot_reader(std::atomic<int>& readers) : readers(readers) { readers.fetch_add(1); }
+  ~snapshot_reader() { readers.fetch_sub(1); }
 
-std::string config::MacAddress(const std::string& interface)
+  std::atomic<int>& readers;
+};
+
+struct config::Interface
 {
-  char mac[18];
-  std::memset(mac, 0, sizeof(mac));
+  std::string name    = "";
+  std::string mac     = "";
+  std::string ip      = "";
+  std::string mask    = "";
+  std::string gateway = "";
+};
 
-  try
+struct config::Snapshot
+{
+  std::vector<Interface> interfaces = {};
+  Ethernets              ethernets  = {};
+
+  std::string selected     = "";  // auto_select 결과
+  std::string select_error = "";  // auto_select 실패 사유
+};
+
+/**
+ * @brief netlink (NETLINK_ROUTE) interface monitor
+ * @details 시작할 때 link, IPv4 address, IPv4 route를 dump 하고, 이후 RTMGRP_LINK / RTMGRP_IPV4_IFADDR / RTMGRP_IPV4_ROUTE 통지로 바뀐 항목만 갱신한다.
+ *          한 번에 도착한 통지를 모두 반영한 뒤 새 snapshot을 한 번 게시한다.
+ *          수신 버퍼가 넘쳐 통지를 잃으면 (ENOBUFS) 다시 dump 한다.
+ */
+class config::Monitor
+{
+ public:
+  ~Monitor() { stop(); }
+
+  void start()
   {
-    auto iface = auto_select_interface(interface);
+    fd_ = ::socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (fd_ < 0)
+      throw std::runtime_error("configure : netlink socket : " + std::string(strerror(errno)));
+
+    // 실패해도 통지를 잃으면 다시 dump 한다
+    int buffer_size = 1 << 20;
+    ::setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
 
-    int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
-    if (fd < 0)
-      throw std::runtime_error("MacAddress : invalid socket : " + std::string(strerror(errno)));
+    // dump 응답 대기
+    struct timeval timeout = { 1, 0 };
+    ::setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
 
-    struct ifreq ifr;
-    std::strncpy(ifr.ifr_name, iface.c_str(), IFNAMSIZ - 1);
-    if (ioctl(fd, SIOCGIFHWADDR, &ifr) < 0)
+    struct sockaddr_nl address = {};
+    address.nl_family          = AF_NETLINK;
+    address.nl_groups          = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV4_ROUTE;
+
+    if (::bind(fd_, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) < 0)
+      throw std::runtime_error("configure : netlink bind : " + std::string(strerror(errno)));
+
+    synchronize();
+
+    worker_ = std::thread(&Monitor::run, this);
+  }
+
+  void stop()
+  {
+    stop_ = true;
+
+    if (worker_.joinable())
+      worker_.join();
+
+    if (fd_ >= 0)
     {
-      ::close(fd);
-      throw std::runtime_error("MacAddress : ioctl : " + std::string(strerror(errno)));
+      ::close(fd_);
+      fd_ = -1;
     }
+  }
 
-    ::close(fd);
-    std::snprintf(mac, sizeof(mac), "%.2x:%.2x:%.2x:%.2x:%.2x:%.2x",
-                  (unsigned char)ifr.ifr_hwaddr.sa_data[0],
-                  (unsigned char)ifr.ifr_hwaddr.sa_data[1],
-                  (unsigned char)ifr.ifr_hwaddr.sa_data[2],
-                  (unsigned char)ifr.ifr_hwaddr.sa_data[3],
-                  (unsigned char)ifr.ifr_hwaddr.sa_data[4],
-                  (unsigned char)ifr.ifr_hwaddr.sa_data[5]);
+ private:
+  struct Address
+  {
+    in_addr_t address   = 0;
+    uint8_t   prefix    = 0;
+    bool      secondary = false;
+  };
+
+  struct Route
+  {
+    in_addr_t gateway = 0;
+    uint32_t  metric  = 0;
+  };
+
+  struct Link
+  {
+    std::string          name      = "";
+    std::string          mac       = "";
+    std::vector<Address> addresses = {};
+    std::vector<Route>   routes    = {};  // default route (main table)
+  };
+
+  void run()
+  {
+    while (stop_ == false)
+    {
+      try
+      {
+        if (resync_)
+        {
+          synchronize();
+          continue;
+        }
+
+        struct pollfd fd = { fd_, POLLIN, 0 };
+
+        if (::poll(&fd, 1, 100) > 0)
+        {
+          while (receive(MSG_DONTWAIT))
+            ;
+        }
+
+        if (changed_)
+        {
+          changed_ = false;
+          config::publish(build());
+        }
+        else
+        {
+          config::reclaim();
+        }
+      }
+      catch (const std::exception& e)
+      {
+        config::set_error(e.what());
+
+        resync_ = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      }
+    }
   }
-  catch (const std::exception& e)
+
+  // 전체 dump 후 snapshot 게시
+  void synchronize()
   {
-    instance_.last_error_ = e.what();
-    return mac;
+    resync_ = false;
+    links_.clear();
+
+    dump(RTM_GETLINK);
+    dump(RTM_GETADDR);
+    dump(RTM_GETROUTE);
+
+    changed_ = false;
+    config::publish(build());
   }
 
-  return mac;
-}
+  void dump(int type)
+  {
+    struct
+    {
+      struct nlmsghdr header;
+      union
+      {
+        struct ifinfomsg link;
+        struct ifaddrmsg address;
+        struct rtmsg     route;
+      } body;
+    } request = {};
+
+    size_t body_size = sizeof(request.body.link);
+    if (type == RTM_GETADDR)
+    {
+      body_size                        = sizeof(request.body.address);
+      request.body.address.ifa_family = AF_INET;
+    }
+    else if (type == RTM_GETROUTE)
+    {
+      body_size                      = sizeof(request.body.route);
+      request.body.route.rtm_family = AF_INET;
+    }
 
-std::string config::IPAddress(const std::string& interface)
-{
-  char ip[INET_ADDRSTRLEN];
-  std::memset(ip, 0, sizeof(ip));
+    dump_sequence_ = ++sequence_;
 
-  try
+    request.header.nlmsg_len   = NLMSG_LENGTH(body_size);
+    request.header.nlmsg_type  = type;
+    request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    request.header.nlmsg_seq   = dump_sequence_;
+
+    struct sockaddr_nl kernel = {};
+    kernel.nl_family          = AF_NETLINK;
+
+    if (::sendto(fd_, &request, request.header.nlmsg_len, 0, reinterpret_cast<struct sockaddr*>(&kernel), sizeof(kernel)) < 0)
+      throw std::runtime_error("configure : netlink send : " + std::string(strerror(errno)));
+
+    // dump 응답 사이에 도착한 통지도 같이 반영된다
+    while (dump_sequence_ != 0)
+      receive(0);
+  }
+
+  // @return false if there is no message
+  bool receive(int flags)
   {
-    auto iface = auto_select_interface(interface);
+    struct sockaddr_nl sender = {};
+    struct iovec       iov    = { buffer_.data(), buffer_.size() };
+    struct msghdr      msg    = {};
+    msg.msg_name              = &sender;
+    msg.msg_namelen           = sizeof(sender);
+    msg.msg_iov               = &iov;
+    msg.msg_iovlen            = 1;
+
+    ssize_t size = ::recvmsg(fd_, &msg, flags);
+    if (size < 0)
+    {
+      if (errno == EINTR)
+        return true;
+
+      // 통지를 잃었다
+      if (errno == ENOBUFS)
+      {
+        resync_ = true;
+        return true;
+      }
 
-    struct ifaddrs* ifaddr = nullptr;
-    if (getifaddrs(&ifaddr) < 0)
-      throw std::runtime_error("IPAddress : getifaddrs : " + std::string(strerror(errno)));
+      if ((errno == EAGAIN || errno == EWOULDBLOCK) && (flags & MSG_DONTWAIT))
+        return false;
 
-    for (struct ifaddrs* ifa = ifaddr; ifa != nullptr; ifa = ifa->ifa_next)
+      throw std::runtime_error("configure : netlink recv : " + std::string(strerror(errno)));
+    }
+
+    if (size == 0)
+      return false;
+
+    if (msg.msg_flags & MSG_TRUNC)
+      resync_ = true;
+
+    // kernel이 보낸 메시지만
+    if (sender.nl_pid != 0)
+      return true;
+
+    int remain = static_cast<int>(size);
+    for (auto header = reinterpret_cast<struct nlmsghdr*>(buffer_.data()); NLMSG_OK(header, remain); header = NLMSG_NEXT(header, remain))
     {
-      if (ifa->ifa_addr == nullptr)
+      if (header->nlmsg_type == NLMSG_DONE)
+      {
+        if (header->nlmsg_seq == dump_sequence_)
+          dump_sequence_ = 0;
         continue;
+      }
+
+      if (header->nlmsg_type == NLMSG_ERROR)
+      {
+        if (header->nlmsg_seq != dump_sequence_)
+          continue;
 
-      if (std::strcmp(ifa->ifa_name, iface.c_str()) != 0)
+        dump_sequence_ = 0;
+
+        auto error = reinterpret_cast<const struct nlmsgerr*>(NLMSG_DATA(header));
+        if (error->error != 0)
+          throw std::runtime_error("configure : netlink dump : " + std::string(strerror(-error->error)));
         continue;
+      }
 
-      if (ifa->ifa_addr->sa_family == AF_INET)
+      switch (header->nlmsg_type)
       {
-        struct sockaddr_in* sa = (struct sockaddr_in*)ifa->ifa_addr;
-        if (inet_ntop(AF_INET, &sa->sin_addr, ip, INET_ADDRSTRLEN) == nullptr)
-          throw std::runtime_error("IPAddress : inet_ntop : " + std::string(strerror(errno)));
-        break;
+        case RTM_NEWLINK:
+        case RTM_DELLINK:
+          on_link(header);
+          break;
+        case RTM_NEWADDR:
+        case RTM_DELADDR:
+          on_address(header);
+          break;
+        case RTM_NEWROUTE:
+        case RTM_DELROUTE:
+          on_route(header);
+          break;
       }
     }
 
-    freeifaddrs(ifaddr);
+    return true;
   }
-  catch (const std::exception& e)
+
+  void on_link(const struct nlmsghdr* header)
   {
-    instance_.last_error_ = e.what();
-    return ip;
+    if (header->nlmsg_len < NLMSG_LENGTH(sizeof(struct ifinfomsg)))
+      return;
+
+    auto info = reinterpret_cast<const struct ifinfomsg*>(NLMSG_DATA(header));
+
+    if (header->nlmsg_type == RTM_DELLINK)
+    {
+      changed_ |= links_.erase(info->ifi_index) > 0;
+      return;
+    }
+
+    std::string name = "";
+    std::string mac  = format_mac(nullptr, 0);
+
+    int length = IFLA_PAYLOAD(header);
+    for (auto attr = IFLA_RTA(info); RTA_OK(attr, length); attr = RTA_NEXT(attr, length))
+    {
+      if (attr->rta_type == IFLA_IFNAME)
+        name.assign(reinterpret_cast<const char*>(RTA_DATA(attr)), strnlen(reinterpret_cast<const char*>(RTA_DATA(attr)), RTA_PAYLOAD(attr)));
+      else if (attr->rta_type == IFLA_ADDRESS)
+        mac = format_mac(reinterpret_cast<const uint8_t*>(RTA_DATA(attr)), RTA_PAYLOAD(attr));
+    }
+
+    auto& link = links_[info->ifi_index];
+    if (link.name != name || link.mac != mac)
+    {
+      link.name = name;
+      link.mac  = mac;
+      changed_  = true;
+    }
   }
 
-  return ip;
-}
+  void on_address(const struct nlmsghdr* header)
+  {
+    if (header->nlmsg_len < NLMSG_LENGTH(sizeof(struct ifaddrmsg)))
+      return;
 
-std::string config::Gateway(const std::string& interface)
-{
-  char gateway[INET_ADDRSTRLEN];
-  std::memset(gateway, 0, sizeof(gateway));
+    auto info = reinterpret_cast<const struct ifaddrmsg*>(NLMSG_DATA(header));
+    if (info->ifa_family != AF_INET)
+      return;
 
-  try
+    // IFA_LOCAL : 인터페이스 주소 (point-to-point에서 IFA_ADDRESS는 상대 주소)
+    Address address   = {};
+    bool    has_local = false;
+
+    int length = IFA_PAYLOAD(header);
+    for (auto attr = IFA_RTA(info); RTA_OK(attr, length); attr = RTA_NEXT(attr, length))
+    {
+      if (RTA_PAYLOAD(attr) < sizeof(in_addr_t))
+        continue;
+
+      if (attr->rta_type == IFA_LOCAL)
+      {
+        std::memcpy(&address.address, RTA_DATA(attr), sizeof(in_addr_t));
+        has_local = true;
+      }
+      else if (attr->rta_type == IFA_ADDRESS && has_local == false)
+      {
+        std::memcpy(&address.address, RTA_DATA(attr), sizeof(in_addr_t));
+      }
+    }
+
+    address.prefix    = info->ifa_prefixlen;
+    address.secondary = (info->ifa_flags & IFA_F_SECONDARY) != 0;
+
+    auto match = [&](const Address& a) { return a.address == address.address && a.prefix == address.prefix; };
+
+    if (header->nlmsg_type == RTM_DELADDR)
+    {
+      auto link = links_.find(info->ifa_index);
+      if (link == links_.end())
+        return;
+
+      auto& addresses = link->second.addresses;
+      auto  iter      = std::find_if(addresses.begin(), addresses.end(), match);
+      if (iter != addresses.end())
+      {
+        addresses.erase(iter);
+        changed_ = true;
+      }
+      return;
+    }
+
+    auto& addresses = links_[info->ifa_index].addresses;
+    auto  iter      = std::find_if(addresses.begin(), addresses.end(), match);
+    if (iter == addresses.end())
+    {
+      addresses.push_back(address);
+      changed_ = true;
+    }
+    else if (iter->secondary != address.secondary)
+    {
+      iter->secondary = address.secondary;
+      changed_        = true;
+    }
+  }
+
+  void on_route(const struct nlmsghdr* header)
   {
-    auto iface = auto_select_interface(interface);
+    if (header->nlmsg_len < NLMSG_LENGTH(sizeof(struct rtmsg)))
+      return;
 
-    std::ifstream route_file("/proc/net/route");
-    if (!route_file.is_open())
-      throw std::runtime_error("Gateway : open : /proc/net/route");
+    // IPv4 default route (/proc/net/route와 같이 main table)
+    auto info = reinterpret_cast<const struct rtmsg*>(NLMSG_DATA(header));
+    if (info->rtm_family != AF_INET || info->rtm_dst_len != 0 || info->rtm_type != RTN_UNICAST)
+      return;
 
-    std::string line;
-    while (std::getline(route_file, line))
+    uint32_t table = info->rtm_table;
+    int      oif   = 0;
+    Route    route = {};
+
+    int length = RTM_PAYLOAD(header);
+    for (auto attr = RTM_RTA(info); RTA_OK(attr, length); attr = RTA_NEXT(attr, length))
     {
-      std::istringstream ss(line);
-      std::string        iface_name, destination, gateway_ip;
+      if (RTA_PAYLOAD(attr) < sizeof(uint32_t))
+        continue;
 
-      ss >> iface_name >> destination >> gateway_ip;
-      if (iface_name == iface && destination == "00000000")
+      switch (attr->rta_type)
       {
-        unsigned long     gw;
-        std::stringstream ss_gateway;
-        ss_gateway << std::hex << gateway_ip;
-        ss_gateway >> gw;
+        case RTA_TABLE:
+          std::memcpy(&table, RTA_DATA(attr), sizeof(table));
+          break;
+        case RTA_OIF:
+          std::memcpy(&oif, RTA_DATA(attr), sizeof(oif));
+          break;
+        case RTA_GATEWAY:
+          std::memcpy(&route.gateway, RTA_DATA(attr), sizeof(route.gateway));
+          break;
+        case RTA_PRIORITY:
+          std::memcpy(&route.metric, RTA_DATA(attr), sizeof(route.metric));
+          break;
+      }
+    }
 
-        struct in_addr in;
-        in.s_addr = gw;
-        snprintf(gateway, sizeof(gateway), "%s", inet_ntoa(in));
+    if (table != RT_TABLE_MAIN || oif == 0)
+      return;
 
-        break;
+    auto match = [&](const Route& r) { return r.gateway == route.gateway && r.metric == route.metric; };
+
+    if (header->nlmsg_type == RTM_DELROUTE)
+    {
+      auto link = links_.find(oif);
+      if (link == links_.end())
+        return;
+
+      auto& routes = link->second.routes;
+      auto  iter   = std::find_if(routes.begin(), routes.end(), match);
+      if (iter != routes.end())
+      {
+        routes.erase(iter);
+        changed_ = true;
       }
+      return;
     }
 
-    route_file.close();
+    auto& routes = links_[oif].routes;
+    if (std::find_if(routes.begin(), routes.end(), match) == routes.end())
+    {
+      routes.push_back(route);
+      changed_ = true;
+    }
   }
-  catch (const std::exception& e)
+
+  const Snapshot* build() const
   {
-    instance_.last_error_ = e.what();
-    return gateway;
+    auto snapshot = std::make_unique<Snapshot>();
+
+    for (const auto& [index, link] : links_)
+    {
+      // RTM_NEWLINK 전에 도착한 주소, 경로
+      if (link.name.empty())
+        continue;
+
+      Interface iface;
+      iface.name = link.name;
+      iface.mac  = link.mac;
+
+      // primary address
+      auto address = std::find_if(link.addresses.begin(), link.addresses.end(), [](const Address& a) { return a.secondary == false; });
+      if (address == link.addresses.end())
+        address = link.addresses.begin();
+
+      if (address != link.addresses.end())
+      {
+        iface.ip   = format_address(address->address);
+        iface.mask = format_address(address->prefix == 0 ? 0 : htonl(~uint32_t(0) << (32 - address->prefix)));
+      }
+
+      // metric이 가장 작은 default route
+      auto route = std::min_element(link.routes.begin(), link.routes.end(), [](const Route& a, const Route& b) { return a.metric < b.metric; });
+      if (route != link.routes.end())
+        iface.gateway = format_address(route->gateway);
+
+      if (is_ethernet_interface(iface.name))
+        snapshot->ethernets.push_back(iface.name);
+
+      snapshot->interfaces.push_back(std::move(iface));
+    }
+
+    try
+    {
+      snapshot->selected = select_interface(snapshot->ethernets);
+    }
+    catch (const std::exception& e)
+    {
+      snapshot->select_error = e.what();
+    }
+
+    return snapshot.release();
   }
 
-  return gateway;
+ private:
+  int               fd_     = -1;
+  std::thread       worker_ = {};
+  std::atomic_bool  stop_   = false;
+
+  uint32_t sequence_      = 0;
+  uint32_t dump_sequence_ = 0;  // 응답을 기다리는 dump (0 : 없음)
+
+  bool changed_ = false;  // 게시하지 않은 변경
+  bool resync_  = false;  // 통지를 잃어 다시 dump 해야 한다
+
+  std::map<int, Link>      links_  = {};  // key : interface index
+  std::array<char, 65536> buffer_ = {};
+};
+
+config::config() = default;
+
+config::~config()
+{
+  release();
 }
 
-std::string config::SubnetMask(const std::string& interface)
+void config::release()
 {
-  char subnet[INET_ADDRSTRLEN];
-  std::memset(subnet, 0, sizeof(subnet));
+  std::lock_guard<std::mutex> locker(instance_.mutex_);
+
+  instance_.monitor_.reset();
+  instance_.configured_ = false;
+
+  auto snapshot = instance_.snapshot_.exchange(nullptr);
+  if (snapshot != nullptr)
+    instance_.retired_.push_back(snapshot);
+
+  while (instance_.readers_.load() != 0)
+    std::this_thread::yield();
+
+  for (auto retired : instance_.retired_)
+    delete retired;
+  instance_.retired_.clear();
+
+  instance_.available_interfaces_.clear();
+
+  std::lock_guard<std::mutex> error_locker(instance_.error_mutex_);
+  instance_.last_error_.clear();
+}
+
+void config::configure()
+{
+  release();
+  start();
+}
+
+void config::start()
+{
+  std::lock_guard<std::mutex> locker(instance_.mutex_);
+
+  if (instance_.configured_)
+    return;
 
   try
   {
-    auto iface = auto_select_interface(interface);
+    auto monitor = std::make_unique<Monitor>();
+    monitor->start();
 
-    int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
-    if (fd < 0)
-      throw std::runtime_error("Subnet : invalid socket : " + std::string(strerror(errno)));
+    instance_.monitor_ = std::move(monitor);
+  }
+  catch (const std::exception& e)
+  {
+    set_error(e.what());
 
-    struct ifreq ifr;
-    std::strncpy(ifr.ifr_name, iface.c_str(), IFNAMSIZ - 1);
-    if (ioctl(fd, SIOCGIFNETMASK, &ifr) < 0)
+    try
+    {
+      instance_.available_interfaces_ = query_interfaces();
+    }
+    catch (const std::exception& e)
     {
-      ::close(fd);
-      throw std::runtime_error("Subnet : ioctl : " + std::string(strerror(errno)));
+      set_error(e.what());
     }
+  }
 
-    ::close(fd);
+  instance_.configured_ = true;
+}
+
+config::Ethernets config::InterfaceList()
+{
+  if (instance_.configured_ == false)
+    start();
+
+  {
+    snapshot_reader reader(instance_.readers_);
 
-    inet_ntop(AF_INET, &(((struct sockaddr_in*)&ifr.ifr_netmask)->sin_addr), subnet, INET_ADDRSTRLEN);
+    auto snapshot = instance_.snapshot_.load();
+    if (snapshot != nullptr)
+      return snapshot->ethernets;
+  }
+
+  std::lock_guard<std::mutex> locker(instance_.mutex_);
+  return instance_.available_interfaces_;
+}
+
+std::string config::MacAddress(const std::string& interface)
+{
+  std::string mac;
+
+  try
+  {
+    if (find_interface("MacAddress", interface, &Interface::mac, mac) == false)
+      mac = query_mac_address(auto_select_interface(interface));
   }
   catch (const std::exception& e)
   {
-    instance_.last_error_ = e.what();
-    return subnet;
+    set_error(e.what());
+    mac.clear();
   }
 
-  return subnet;
+  return mac;
 }
 
-std::string config::auto_select_interface(const std::string& interface, bool retry)
+std::string config::IPAddress(const std::string& interface)
 {
-  if (interface != auto_select)
-    return interface;
+  std::string ip;
 
-  if (instance_.available_interfaces_.empty())
+  try
   {
-    if (retry)
-      throw std::runtime_error("No available interface");
+    if (find_interface("IPAddress", interface, &Interface::ip, ip) == false)
+      ip = query_ip_address(auto_select_interface(interface));
+  }
+  catch (const std::exception& e)
+  {
+    set_error(e.what());
+    ip.clear();
+  }
 
-    configure();
-    return auto_select_interface(interface, true);
+  return ip;
+}
+
+std::string config::Gateway(const std::string& interface)
+{
+  std::string gateway;
+
+  try
+  {
+    if (find_interface("Gateway", interface, &Interface::gateway, gateway) == false)
+      gateway = query_gateway(auto_select_interface(interface));
+  }
+  catch (const std::exception& e)
+  {
+    set_error(e.what());
+    gateway.clear();
   }
 
-  if (instance_.available_interfaces_.size() == 1)
-    return instance_.available_interfaces_.front();
+  return gateway;
+}
 
-  if (instance_.available_interfaces_.size() > 1)
+std::string config::SubnetMask(const std::string& interface)
+{
+  std::string subnet;
+
+  try
   {
-    Ethernets candidates;
-    for (const auto& candidate : instance_.available_interfaces_)
-    {
-      std::string iface = candidate;
+    if (find_interface("Subnet", interface, &Interface::mask, subnet) == false)
+      subnet = query_subnet_mask(auto_select_interface(interface));
+  }
+  catch (const std::exception& e)
+  {
+    set_error(e.what());
+    subnet.clear();
+  }
 
-      // remove ETHERNET_INTERFACES
-      for (auto remove_key : ETHERNET_INTERFACES)
-      {
-        if (iface.find(remove_key) != std::string::npos)
-        {
-          iface.erase(0, std::strlen(remove_key));
-          break;
-        }
-      }
+  return subnet;
+}
 
-      // Parse the interface number
-      if (iface.empty() == false && std::isdigit(iface[0]))
-      {
-        std::string number = "";
-        number             = iface.substr(0, iface.find_first_not_of("0123456789"));
+std::string config::LastError()
+{
+  std::lock_guard<std::mutex> locker(instance_.error_mutex_);
+  return instance_.last_error_;
+}
 
-        if (std::stoi(number) == 0)
-          candidates.push_back(candidate);
-      }
-    }
+bool config::find_interface(const char* caller, const std::string& interface, std::string Interface::*field, std::string& value)
+{
+  if (instance_.configured_ == false)
+    start();
+
+  std::string error;
+
+  {
+    snapshot_reader reader(instance_.readers_);
 
-    if (candidates.size() == 1)
-      return candidates.front();
+    auto snapshot = instance_.snapshot_.load();
+    if (snapshot == nullptr)
+      return false;
+
+    if (interface == auto_select && snapshot->selected.empty())
+    {
+      error = snapshot->select_error;
+    }
     else
-      throw std::runtime_error("Two or more `0` interfaces exist");
+    {
+      const std::string& name = interface == auto_select ? snapshot->selected : interface;
+
+      auto iter = std::find_if(snapshot->interfaces.begin(), snapshot->interfaces.end(), [&](const Interface& iface) { return iface.name == name; });
+      if (iter != snapshot->interfaces.end())
+        value = (*iter).*field;
+      else
+        error = std::string(caller) + " : no such interface : " + name;
+    }
+  }
+
+  if (error.empty() == false)
+    throw std::runtime_error(error);
+
+  return true;
+}
+
+void config::publish(const Snapshot* snapshot)
+{
+  auto previous = instance_.snapshot_.exchange(snapshot);
+  if (previous != nullptr)
+    instance_.retired_.push_back(previous);
+
+  reclaim();
+}
+
+void config::reclaim()
+{
+  // readers_가 0이면 교체 전 snapshot을 들고 있는 thread가 없다 (이후 reader는 새 snapshot을 읽는다)
+  if (instance_.retired_.empty() || instance_.readers_.load() != 0)
+    return;
+
+  for (auto retired : instance_.retired_)
+    delete retired;
+  instance_.retired_.clear();
+}
+
+void config::set_error(const std::string& error)
+{
+  std::lock_guard<std::mutex> locker(instance_.error_mutex_);
+  instance_.last_error_ = error;
+}
+
+std::string config::auto_select_interface(const std::string& interface, bool retry)
+{
+  if (interface != auto_select)
+    return interface;
+
+  Ethernets interfaces;
+  {
+    std::lock_guard<std::mutex> locker(instance_.mutex_);
+    interfaces = instance_.available_interfaces_;
+  }
+
+  if (interfaces.empty())
+  {
+    if (retry)
+      throw std::runtime_error("No available interface");
+
+    configure();
+    return auto_select_interface(interface, true);
   }
 
-  throw std::runtime_error("No available interface");
+  return select_interface(interfaces);
 }
 
 }  // namespace network
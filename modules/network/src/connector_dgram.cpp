@@ -1,6 +1,7 @@
 
 #include <fcntl.h>
 
+#include <algorithm>
 #include <rowen/core/exception.hpp>
 #include <rowen/network/connector_dgram.hpp>
 
@@ -13,19 +14,17 @@ bool dgram_connector::initialize(const std::string& server_address,
                                  const int          server_port,
                                  const argument&    args)
 {
-  server_ipv4_ = server_address;
-  server_port_ = server_port;
-
-  server_addr_.sin_family      = AF_INET;
-  server_addr_.sin_addr.s_addr = inet_addr(server_ipv4_.c_str());
-  server_addr_.sin_port        = htons(server_port_);
+  set_server(server_address, server_port);
 
   try
   {
     std::lock_guard<std::mutex> locker(connector_locker_);
 
+    // resolve server address
+    const auto& endpoint = resolve_server(SOCK_DGRAM);
+
     // create socket
-    if (socket_.open(SOCK_DGRAM, args.socket_protocol) == false)
+    if (socket_.open(SOCK_DGRAM, args.socket_protocol, endpoint.family()) == false)
       throw rs::exception("open socket : " + socket_.error());
 
     // set socket option : recv default flags
@@ -44,10 +43,26 @@ bool dgram_connector::initialize(const std::string& server_address,
     // set socket option : send timeout
     if (socket_.setSendTimeout(args.send_timeout) == false)
       throw rs::exception("set send_timeout" + socket_.error());
+
+    // set socket option : UDP GSO (kernel 지원 여부를 확인한다, segment size는 전송마다 지정한다)
+    segment_size_    = 0;
+    segment_offload_ = false;
+    if (args.send_segment_size > 0)
+    {
+      if (args.send_segment_size > MAX_UDP_PAYLOAD_SIZE)
+        throw rs::exception("invalid send_segment_size");
+
+      int segment_size = args.send_segment_size;
+      if (socket_.setOption(SOL_UDP, UDP_SEGMENT, &segment_size, sizeof(segment_size)) == false)
+        throw rs::exception("set udp_segment : " + socket_.error());
+
+      segment_size_    = static_cast<uint16_t>(segment_size);
+      segment_offload_ = true;
+    }
   }
   catch (const rs::exception& e)
   {
-    error_ = e.what();
+    set_error(e.what());
     return false;
   }
 
@@ -56,24 +71,47 @@ bool dgram_connector::initialize(const std::string& server_address,
 
 ssize_t dgram_connector::sendto(const uint8_t* data, size_t size, int send_flags)
 {
-  server_addr_len_ = sizeof(server_addr_);
-
-  return sendto(data, size, (struct sockaddr*)&server_addr_, server_addr_len_, send_flags);
+  return sendto(data, size, server_endpoint_.data(), server_endpoint_.size, send_flags);
 }
 
 ssize_t dgram_connector::sendto(const uint8_t* data, size_t size, const struct sockaddr* addr, const socklen_t addrlen, int send_flags)
 {
-  ssize_t res = 0;
+  std::lock_guard<std::mutex> locker(connector_locker_);
 
+  if (segment_size_ == 0 || size <= segment_size_)
   {
-    std::lock_guard<std::mutex> locker(connector_locker_);
-    res = socket_.send(data, size, send_flags, addr, addrlen);
+    ssize_t res = socket_.send(data, size, send_flags, addr, addrlen);
+    if (res <= 0)
+      set_error(socket_.error());
+
+    return res;
   }
 
-  if (res <= 0)
-    error_ = socket_.error();
+  if (segment_offload_ == false)
+    return send_split(data, size, addr, addrlen, send_flags);
 
-  return res;
+  size_t  sent_size = 0;
+  ssize_t res       = socket_.sendSegments(data, size, segment_size_, send_flags, addr, addrlen, &sent_size);
+  if (res > 0)
+    return res;
+
+  // 경로 (장치의 TX checksum offload 미지원, IPsec 등)가 GSO를 지원하지 않으면 모든 segment 전송이 EIO로 실패한다
+  if (errno != EIO)
+  {
+    set_error(socket_.error());
+    return res;
+  }
+
+  int disabled = 0;
+  socket_.setOption(SOL_UDP, UDP_SEGMENT, &disabled, sizeof(disabled));
+
+  segment_offload_ = false;
+  set_error("udp_segment : " + std::string(::strerror(EIO)) + " (fallback to datagram batch)");
+
+  // 전송되지 않은 나머지를 datagram으로 나누어 다시 전송한다
+  res = send_split(data + sent_size, size - sent_size, addr, addrlen, send_flags);
+
+  return res < 0 ? res : static_cast<ssize_t>(size);
 }
 
 ssize_t dgram_connector::sendto(const rs::Packet& packet, int send_flags)
@@ -88,9 +126,95 @@ ssize_t dgram_connector::sendto(const rs::Packet& packet, const struct sockaddr*
   return sendto(packet.data(), packet.size(), addr, addrlen, send_flags);
 }
 
+ssize_t dgram_connector::sendto_batch(const rs::PacketSpan* datagrams, size_t count, int send_flags)
+{
+  return sendto_batch(datagrams, count, server_endpoint_.data(), server_endpoint_.size, send_flags);
+}
+
+ssize_t dgram_connector::sendto_batch(const rs::PacketSpan* datagrams, size_t count, const struct sockaddr* addr, const socklen_t addrlen, int send_flags)
+{
+  if (datagrams == nullptr || count == 0)
+  {
+    set_error("invalid data buffer");
+    return -1;
+  }
+
+  std::lock_guard<std::mutex> locker(connector_locker_);
+
+  return send_batch(datagrams, count, addr, addrlen, send_flags);
+}
+
+ssize_t dgram_connector::send_batch(const rs::PacketSpan* datagrams, size_t count, const struct sockaddr* addr, const socklen_t addrlen, int send_flags)
+{
+  // header는 스택에 두고 MAX_SEND_BATCH 단위로 전송한다 (할당 없음)
+  struct mmsghdr messages[MAX_SEND_BATCH];
+  struct iovec   vectors[MAX_SEND_BATCH];
+
+  ssize_t total_count = 0;
+
+  while (total_count < static_cast<ssize_t>(count))
+  {
+    const size_t batch_count = std::min(MAX_SEND_BATCH, count - total_count);
+
+    for (size_t i = 0; i < batch_count; ++i)
+    {
+      vectors[i].iov_base = const_cast<uint8_t*>(datagrams[total_count + i].data);
+      vectors[i].iov_len  = datagrams[total_count + i].size;
+
+      messages[i]                     = {};
+      messages[i].msg_hdr.msg_iov     = &vectors[i];
+      messages[i].msg_hdr.msg_iovlen  = 1;
+      messages[i].msg_hdr.msg_name    = const_cast<struct sockaddr*>(addr);
+      messages[i].msg_hdr.msg_namelen = addrlen;
+    }
+
+    int res = socket_.sendBatch(messages, batch_count, send_flags);
+    if (res <= 0)
+    {
+      set_error(socket_.error());
+      break;
+    }
+
+    total_count += res;
+
+    if (res < static_cast<int>(batch_count))
+      break;
+  }
+
+  return total_count > 0 ? total_count : -1;
+}
+
+ssize_t dgram_connector::send_split(const uint8_t* data, size_t size, const struct sockaddr* addr, const socklen_t addrlen, int send_flags)
+{
+  rs::PacketSpan datagrams[MAX_SEND_BATCH];
+
+  size_t offset = 0;
+
+  while (offset < size)
+  {
+    size_t count = 0;
+    for (; count < MAX_SEND_BATCH && offset + count * segment_size_ < size; ++count)
+    {
+      const size_t begin = offset + count * segment_size_;
+      datagrams[count]   = { data + begin, std::min<size_t>(segment_size_, size - begin) };
+    }
+
+    if (send_batch(datagrams, count, addr, addrlen, send_flags) != static_cast<ssize_t>(count))
+      return -1;
+
+    offset += count * segment_size_;
+  }
+
+  return static_cast<ssize_t>(size);
+}
+
 ssize_t dgram_connector::recvfrom(uint8_t* data, size_t size, int recv_flags)
 {
-  return recvfrom(data, size, (struct sockaddr*)&server_addr_, &server_addr_len_, recv_flags);
+  // 송신측 주소는 버린다 (preset 주소를 바꾸지 않는다)
+  struct sockaddr_storage sender_addr     = {};
+  socklen_t               sender_addr_len = sizeof(sender_addr);
+
+  return recvfrom(data, size, (struct sockaddr*)&sender_addr, &sender_addr_len, recv_flags);
 }
 
 ssize_t dgram_connector::recvfrom(uint8_t* data, size_t size, struct sockaddr* addr, socklen_t* addrlen, int recv_flags)
@@ -101,11 +225,11 @@ ssize_t dgram_connector::recvfrom(uint8_t* data, size_t size, struct sockaddr* a
   {
     if (errno == EAGAIN)
     {
-      error_ = "receive timeout";
+      set_error("receive timeout");
     }
     else
     {
-      error_ = socket_.error();
+      set_error(socket_.error());
     }
   }
 
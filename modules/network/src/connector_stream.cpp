@@ -1,6 +1,8 @@
 #include <assert.h>
 #include <fcntl.h>
 
+#include <algorithm>
+#include <random>
 #include <rowen/core/exception.hpp>
 #include <rowen/network/connector_stream.hpp>
 
@@ -9,30 +11,74 @@ namespace network {
 
 const stream_connector::argument stream_connector::default_arguments_ = {};
 
+stream_connector::~stream_connector()
+{
+  stop_reconnect();
+}
+
 void stream_connector::initialize(const std::string& server_address,
                                   const int          server_port,
                                   const argument&    args)
 {
-  server_ipv4_    = server_address;
-  server_port_    = server_port;
+  stop_reconnect();
+
+  set_server(server_address, server_port);
   last_arguments_ = args;
+
+  if (args.reconnect_async)
+    start_reconnect();
 }
 
 bool stream_connector::connect(const std::string& server_address,
                                const int          server_port,
                                const argument&    args)
 {
-  server_ipv4_    = server_address;
-  server_port_    = server_port;
+  stop_reconnect();
+
+  set_server(server_address, server_port);
   last_arguments_ = args;
 
+  // 비동기 재접속은 한 번만 시도하고 (connect_timeout까지), 실패하면 background thread가 재접속한다
+  bool connected = open_connection(args, args.reconnect_async == false) && activate_connection();
+
+  if (args.reconnect_async)
+    start_reconnect();
+
+  return connected;
+}
+
+bool stream_connector::activate_connection()
+{
+  // 보관된 데이터를 먼저 전송한 뒤 연결 상태로 바꾼다 (send()의 순서 유지)
+  std::lock_guard<std::mutex> offline_locker(offline_mutex_);
+
+  if (flush_offline() == false)
+  {
+    std::lock_guard<std::mutex> locker(connector_locker_);
+
+    uring_ = nullptr;
+    socket_.close();
+    return false;
+  }
+
+  set_error("");
+  connected_ = true;
+
+  return true;
+}
+
+bool stream_connector::open_connection(const argument& args, bool wait_forever)
+{
   try
   {
     {
       std::lock_guard<std::mutex> locker(connector_locker_);
 
+      // resolve server address (재접속은 해석된 주소를 그대로 사용한다)
+      const auto& endpoint = resolve_server(SOCK_STREAM);
+
       // create socket
-      if (socket_.open(SOCK_STREAM, args.socket_protocol) == false)
+      if (socket_.open(SOCK_STREAM, args.socket_protocol, endpoint.family()) == false)
         throw rs::exception("open socket" + socket_.error());
 
       // set socket option : recv default flags
@@ -51,6 +97,10 @@ bool stream_connector::connect(const std::string& server_address,
       // set socket option : send timeout
       if (socket_.setSendTimeout(args.send_timeout) == false)
         throw rs::exception("set send_timeout" + socket_.error());
+
+      // set socket option : TCP profile (socket 버퍼는 connect 전에 설정해야 window scale에 반영된다)
+      if (socket_.applyTcpProfile(args.tcp_profile) == false)
+        set_error("set tcp_profile : " + socket_.error());
     }
 
     // connection
@@ -68,14 +118,14 @@ bool stream_connector::connect(const std::string& server_address,
       if (timeout_sec < 0.01)
         timeout_sec = 0.5;
 
-      if (socket_.connect(server_address, server_port) == false)
+      if (socket_.connect(server_endpoint_) == false)
       {
         if (errno != EINPROGRESS)
           throw rs::exception("connect : " + socket_.error());
 
         do
         {
-          std::lock_guard<std::mutex> locker(connector_locker_);
+          std::unique_lock<std::mutex> locker(connector_locker_);
 
           FD_ZERO(&fdset);
           FD_SET(socket_.id(), &fdset);
@@ -88,11 +138,14 @@ bool stream_connector::connect(const std::string& server_address,
 
           if (res <= 0)
           {
-            if (args.connect_timeout >= 0)
+            if (args.connect_timeout >= 0 || wait_forever == false)
               throw rs::exception("connect : timeout : " + std::string(::strerror(errno)));
             else  // retry connection
             {
-              error_ = "waiting for connection";
+              set_error("waiting for connection");
+
+              // 대기하는 동안 lock을 잡고 있지 않는다
+              locker.unlock();
               usleep(100 * 1000);
               continue;
             }
@@ -119,30 +172,70 @@ bool stream_connector::connect(const std::string& server_address,
   }
   catch (const rs::exception& e)
   {
-    error_ = e.what();
+    std::lock_guard<std::mutex> locker(connector_locker_);
+
+    socket_.close();
+
+    set_error(e.what());
     return false;
   }
 
-  error_.clear();
-  connected_ = true;
+  // io_uring send path (지원하지 않는 kernel은 socket으로 전송한다)
+  {
+    std::lock_guard<std::mutex> locker(connector_locker_);
+
+    uring_ = nullptr;
+    if (args.connector_backend == backend::io_uring && Uring::supported())
+    {
+      uring_ = std::make_unique<Uring>();
+      if (uring_->open(8) == false)
+        uring_ = nullptr;
+    }
+  }
 
   return true;
 }
 
 void stream_connector::disconnect()
 {
-  std::lock_guard<std::mutex> locker(connector_locker_);
+  stop_reconnect();
+  close_connection();
+}
+
+void stream_connector::close_connection()
+{
+  {
+    std::lock_guard<std::mutex> locker(connector_locker_);
+
+    connected_ = false;
+    uring_     = nullptr;
+    socket_.close();
+  }
 
-  connected_ = false;
-  socket_.close();
+  // background thread에 재접속을 알린다
+  {
+    std::lock_guard<std::mutex> locker(reconnect_mutex_);
+  }
+  reconnect_cv_.notify_all();
 }
 
-ssize_t stream_connector::send(const uint8_t* data, size_t size, int send_flags, int retry_flag)
+size_t stream_connector::offline_size() const
 {
-  if (connected_ == false && connect(server_ipv4_, server_port_, last_arguments_) == false)
+  std::lock_guard<std::mutex> locker(offline_mutex_);
+  return offline_size_;
+}
+
+template <typename Data>
+ssize_t stream_connector::send_with_retry(const Data& data, int send_flags, int retry_flag)
+{
+  // 재접속은 background thread가 한다
+  if (last_arguments_.reconnect_async)
+    return send_or_buffer(data, send_flags);
+
+  if (connected_ == false && connect(server_address_, server_port_, last_arguments_) == false)
     return -1;
 
-  auto res = try_send(data, size, send_flags);
+  auto res = try_send(data, send_flags);
 
   // check retry flag
   bool retry = (retry_flag < 0) ? last_arguments_.send_retry : (retry_flag != 0);
@@ -151,13 +244,305 @@ ssize_t stream_connector::send(const uint8_t* data, size_t size, int send_flags,
   {
     assert(connected_ == false);
 
-    if (connect(server_ipv4_, server_port_, last_arguments_))
-      res = try_send(data, size, send_flags);
+    if (connect(server_address_, server_port_, last_arguments_))
+      res = try_send(data, send_flags);
   }
 
   return res;
 }
 
+template <typename Data>
+ssize_t stream_connector::try_send(const Data& data, int send_flags)
+{
+  ssize_t res = 0;
+
+  connector_locker_.lock();
+  if (uring_ != nullptr)
+  {
+    if constexpr (std::is_same_v<Data, PacketSpan>)
+      res = uring_send(&data, 1, send_flags);
+    else
+    {
+      auto segments = data.segments();
+      res           = uring_send(segments.data(), segments.size(), send_flags);
+    }
+  }
+  else
+  {
+    if constexpr (std::is_same_v<Data, PacketSpan>)
+      res = socket_.send(data.data, data.size, send_flags);
+    else
+      res = socket_.send(data, send_flags);
+
+    if (res <= 0)
+      set_error(socket_.error());
+  }
+  connector_locker_.unlock();
+
+  if (res == 0)
+    close_connection();
+
+  return res;
+}
+
+template <typename Data>
+ssize_t stream_connector::send_or_buffer(const Data& data, int send_flags)
+{
+  {
+    std::lock_guard<std::mutex> locker(offline_mutex_);
+
+    if (connected_ == false)
+      return buffer_offline(data);
+  }
+
+  auto res = try_send(data, send_flags);
+
+  // 연결이 끊어져서 전송하지 못한 데이터는 재접속 후 전송한다
+  if (res == 0)
+  {
+    std::lock_guard<std::mutex> locker(offline_mutex_);
+    return buffer_offline(data);
+  }
+
+  return res;
+}
+
+template <typename Data>
+ssize_t stream_connector::buffer_offline(const Data& data)
+{
+  const size_t capacity = last_arguments_.offline_buffer_size;
+
+  size_t size = 0;
+  if constexpr (std::is_same_v<Data, PacketSpan>)
+    size = data.size;
+  else
+    size = data.size();
+
+  if (capacity == 0)
+  {
+    set_error("not connected to server");
+    return 0;
+  }
+
+  if (size > capacity || (offline_size_ + size > capacity && last_arguments_.offline_drop_policy == drop_policy::drop_newest))
+  {
+    offline_dropped_++;
+    set_error("offline buffer is full");
+    return -1;
+  }
+
+  while (offline_size_ + size > capacity)
+  {
+    offline_size_ -= offline_queue_.front().size();
+    offline_queue_.pop_front();
+    offline_dropped_++;
+  }
+
+  std::vector<uint8_t> buffer;
+  buffer.reserve(size);
+
+  if constexpr (std::is_same_v<Data, PacketSpan>)
+    buffer.insert(buffer.end(), data.data, data.data + data.size);
+  else
+    for (auto& segment : data.segments())
+      buffer.insert(buffer.end(), segment.data, segment.data + segment.size);
+
+  offline_queue_.push_back(std::move(buffer));
+  offline_size_ += size;
+
+  return size;
+}
+
+bool stream_connector::flush_offline()
+{
+  // offline_mutex_를 잡은 상태로 호출된다
+  while (offline_queue_.empty() == false)
+  {
+    auto& buffer = offline_queue_.front();
+
+    ssize_t res = 0;
+    {
+      std::lock_guard<std::mutex> locker(connector_locker_);
+      res = socket_.send(buffer.data(), buffer.size());
+    }
+
+    if (res <= 0)
+    {
+      set_error(socket_.error());
+      return false;
+    }
+
+    offline_size_ -= buffer.size();
+    offline_queue_.pop_front();
+  }
+
+  return true;
+}
+
+void stream_connector::start_reconnect()
+{
+  reconnect_stop_   = false;
+  reconnect_worker_ = std::async(std::launch::async, &stream_connector::onReconnect, this);
+}
+
+void stream_connector::stop_reconnect()
+{
+  {
+    std::lock_guard<std::mutex> locker(reconnect_mutex_);
+    reconnect_stop_ = true;
+  }
+  reconnect_cv_.notify_all();
+
+  if (reconnect_worker_.valid())
+    reconnect_worker_.wait();
+
+  reconnect_worker_ = {};
+}
+
+void stream_connector::onReconnect()
+{
+  std::mt19937                          random(std::random_device{}());
+  std::uniform_real_distribution<float> jitter(-1, 1);
+
+  const float backoff_min = std::max(last_arguments_.reconnect_backoff_min, 0.001f);
+  const float backoff_max = std::max(last_arguments_.reconnect_backoff_max, backoff_min);
+  const float jitter_rate = std::clamp(last_arguments_.reconnect_jitter, 0.f, 1.f);
+
+  float backoff = backoff_min;
+
+  std::unique_lock<std::mutex> locker(reconnect_mutex_);
+
+  while (reconnect_stop_ == false)
+  {
+    // 연결되어 있는 동안 대기 (close_connection()이 깨운다)
+    if (connected_)
+    {
+      backoff = backoff_min;
+      reconnect_cv_.wait(locker, [&] { return reconnect_stop_ || connected_ == false; });
+      continue;
+    }
+
+    locker.unlock();
+
+    // non-blocking connect (connect_timeout까지 대기한다)
+    bool connected = open_connection(last_arguments_, false) && activate_connection();
+
+    locker.lock();
+
+    if (connected)
+      continue;
+
+    // jittered exponential backoff
+    auto delay = std::chrono::duration<float>(backoff * (1 + jitter_rate * jitter(random)));
+    backoff    = std::min(backoff * 2, backoff_max);
+
+    reconnect_cv_.wait_for(locker, delay, [&] { return reconnect_stop_.load(); });
+  }
+}
+
+ssize_t stream_connector::uring_send(const PacketSpan* segments, size_t count, int send_flags)
+{
+  constexpr uint64_t CANCEL_USER_DATA = UINT64_MAX;
+
+  const int socket = socket_.id();
+  const int flags  = (send_flags < 0 ? last_arguments_.send_flags : send_flags) | MSG_WAITALL;
+
+  // segment를 linked SEND chain으로 제출한다 (MSG_WAITALL : 일부만 전송되면 이후 segment는 취소된다)
+  size_t   total_size = 0;
+  unsigned submitted  = 0;
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (segments[i].size == 0)
+      continue;
+
+    bool link = false;
+    for (size_t j = i + 1; j < count && link == false; ++j)
+      link = segments[j].size > 0;
+
+    if (uring_->prepareSend(socket, segments[i].data, segments[i].size, submitted, flags, link) == false)
+    {
+      set_error("io_uring submission queue is full");
+      return -1;
+    }
+
+    total_size += segments[i].size;
+    submitted++;
+  }
+
+  if (submitted == 0)
+  {
+    set_error("invalid data size");
+    return -1;
+  }
+
+  // 완료 대기 (send timeout이 지나면 남은 요청을 취소하고 취소가 끝날 때까지 기다린다)
+  int timeout_ms = last_arguments_.send_timeout > 0 ? static_cast<int>(last_arguments_.send_timeout * 1000) : -1;
+
+  ssize_t  sent_size = 0;
+  int      error     = 0;
+  unsigned completed = 0;
+
+  while (completed < submitted)
+  {
+    int res = uring_->submit(1, timeout_ms);
+
+    if (res == -ETIME)
+    {
+      error      = ETIMEDOUT;
+      timeout_ms = -1;
+      uring_->prepareCancel(socket, CANCEL_USER_DATA);
+      continue;
+    }
+
+    if (res < 0 && res != -EINTR && res != -EBUSY)
+    {
+      set_error("io_uring_enter : " + std::string(::strerror(-res)));
+      return -1;
+    }
+
+    uring_->drain([&](const struct io_uring_cqe& cqe) {
+      if (cqe.user_data == CANCEL_USER_DATA)
+        return;
+
+      completed++;
+
+      if (cqe.res > 0)
+        sent_size += cqe.res;
+      else if (error == 0 && cqe.res < 0)
+        error = -cqe.res;
+    });
+  }
+
+  if (sent_size == static_cast<ssize_t>(total_size))
+    return sent_size;
+
+  // --- error handling (Socket::send()와 같은 반환값) ----------------------------
+  if (error == 0)
+    error = EPIPE;
+
+  set_error(::strerror(error));
+
+  // 재접속이 필요한 경우와 관련된 에러 코드
+  if (error == EPIPE ||
+      error == ECONNABORTED ||
+      error == ECONNREFUSED ||
+      error == ENETRESET ||
+      error == ECONNRESET ||
+      error == ENOTCONN ||
+      error == ENETDOWN ||
+      error == EHOSTDOWN ||
+      error == EHOSTUNREACH)
+    return 0;
+
+  return -1;
+}
+
+ssize_t stream_connector::send(const uint8_t* data, size_t size, int send_flags, int retry_flag)
+{
+  return send_with_retry(PacketSpan{ data, size }, send_flags, retry_flag);
+}
+
 ssize_t stream_connector::send(const rs::Packet& packet, int send_flags, int retry_flag)
 {
   packet.updateTimestamp();
@@ -165,11 +550,18 @@ ssize_t stream_connector::send(const rs::Packet& packet, int send_flags, int ret
   return send(packet.data(), packet.size(), send_flags, retry_flag);
 }
 
+ssize_t stream_connector::send(const rs::PacketGather& packet, int send_flags, int retry_flag)
+{
+  packet.updateTimestamp();
+
+  return send_with_retry(packet, send_flags, retry_flag);
+}
+
 ssize_t stream_connector::recv(uint8_t* data, size_t size, int recv_flags)
 {
   if (connected_ == false)
   {
-    error_ = "not connected to server";
+    set_error("not connected to server");
     return 0;
   }
 
@@ -177,15 +569,15 @@ ssize_t stream_connector::recv(uint8_t* data, size_t size, int recv_flags)
 
   if (res == 0)
   {
-    error_ = "connection closed : " + socket_.error();
-    disconnect();
+    set_error("connection closed : " + socket_.error());
+    close_connection();
   }
   else if (res < 0)
   {
     if (errno == EAGAIN)
-      error_ = "receive timeout";
+      set_error("receive timeout");
     else
-      error_ = socket_.error();
+      set_error(socket_.error());
   }
 
   return res;
@@ -237,20 +629,5 @@ ssize_t stream_connector::sendToRecv(const uint8_t* send_data, const size_t send
   return received;
 }
 
-ssize_t stream_connector::try_send(const uint8_t* data, size_t size, int send_flags)
-{
-  connector_locker_.lock();
-  auto res = socket_.send(data, size, send_flags);
-  connector_locker_.unlock();
-
-  if (res <= 0)
-    error_ = socket_.error();
-
-  if (res == 0)
-    disconnect();
-
-  return res;
-}
-
 };  // namespace network
 };  // namespace rs
@@ -0,0 +1,408 @@
+#include <algorithm>
+#include <chrono>
+#include <rowen/core/exception.hpp>
+#include <rowen/network/connector_stream_pool.hpp>
+#include <thread>
+
+namespace rs {
+namespace network {
+
+const stream_connector_pool::argument stream_connector_pool::default_arguments_ = {};
+
+namespace {
+
+// 만료된 요청을 확인하는 간격 (receive thread는 수신이 없어도 이 간격으로 깨어난다)
+constexpr float EXPIRE_INTERVAL = 0.1f;
+
+}  // namespace
+
+stream_connector_pool::~stream_connector_pool()
+{
+  disconnect();
+}
+
+bool stream_connector_pool::connect(const std::string& server_address,
+                                    const int          server_port,
+                                    const argument&    args)
+{
+  disconnect();
+
+  try
+  {
+    if (args.connections <= 0)
+      throw rs::exception("invalid connections");
+
+    if (args.recv_buffer_size <= 0)
+      throw rs::exception("invalid recv_buffer_size");
+
+    server_address_ = server_address;
+    server_port_    = server_port;
+    arguments_      = args;
+
+    // 응답이 없어도 receive thread가 만료된 요청을 정리할 수 있도록 한다
+    if (arguments_.connector.recv_timeout <= 0 || arguments_.connector.recv_timeout > EXPIRE_INTERVAL)
+      arguments_.connector.recv_timeout = EXPIRE_INTERVAL;
+
+    // warm connections
+    size_t      connected  = 0;
+    std::string last_error = "";
+
+    for (int i = 0; i < args.connections; ++i)
+    {
+      auto channel   = std::make_unique<Channel>();
+      channel->index = i;
+
+      if (channel->connector.connect(server_address, server_port, arguments_.connector))
+        connected++;
+      else
+        last_error = "connect : " + std::string(channel->connector.error() ? channel->connector.error() : "");
+
+      channels_.push_back(std::move(channel));
+    }
+
+    // receive thread (끊어진 connection은 receive thread가 재접속한다)
+    stop_ = false;
+
+    for (auto& channel : channels_)
+      channel->worker = std::async(std::launch::async, &stream_connector_pool::onReceiveMessage, this, channel.get());
+
+    if (connected == 0)
+      throw rs::exception(last_error);
+  }
+  catch (const rs::exception& e)
+  {
+    disconnect();
+
+    set_error(e.what());
+    return false;
+  }
+
+  set_error("");
+  return true;
+}
+
+void stream_connector_pool::disconnect()
+{
+  stop_ = true;
+
+  // 대기 중인 recv()를 깨운다
+  for (auto& channel : channels_)
+    channel->connector.socket().shutdown(SHUT_RDWR);
+
+  for (auto& channel : channels_)
+  {
+    if (channel->worker.valid())
+      channel->worker.wait();
+
+    channel->connector.disconnect();
+    fail_requests(*channel, "disconnected");
+  }
+
+  channels_.clear();
+}
+
+stream_connector_pool::Response stream_connector_pool::request(const rs::Packet& packet, int send_flags, float timeout)
+{
+  return send_request(packet, send_flags, timeout);
+}
+
+stream_connector_pool::Response stream_connector_pool::request(const rs::PacketGather& packet, int send_flags, float timeout)
+{
+  return send_request(packet, send_flags, timeout);
+}
+
+bool stream_connector_pool::sendToRecv(const rs::Packet& packet, rs::Packet& response, float timeout, int send_flags)
+{
+  Channel* channel    = nullptr;
+  uint32_t request_id = 0;
+
+  auto future = send_request(packet, send_flags, timeout, &channel, &request_id);
+
+  try
+  {
+    if (timeout > 0 && future.wait_for(std::chrono::duration<float>(timeout)) != std::future_status::ready)
+    {
+      // 응답하지 않는 요청이 쌓이지 않도록 대기 목록에서 제거한다
+      if (channel != nullptr)
+        cancel_request(*channel, request_id);
+
+      throw rs::exception("receive timeout");
+    }
+
+    response = future.get();
+  }
+  catch (const rs::exception& e)
+  {
+    set_error(e.what());
+    return false;
+  }
+
+  return true;
+}
+
+const char* stream_connector_pool::error() const
+{
+  thread_local std::string error;
+
+  {
+    std::lock_guard<std::mutex> locker(error_mutex_);
+    error = error_;
+  }
+
+  return error.empty() ? nullptr : error.c_str();
+}
+
+size_t stream_connector_pool::connections() const
+{
+  size_t count = 0;
+  for (auto& channel : channels_)
+    count += channel->connector.isConnected() ? 1 : 0;
+
+  return count;
+}
+
+size_t stream_connector_pool::pending() const
+{
+  size_t count = 0;
+  for (auto& channel : channels_)
+    count += channel->inflight.load(std::memory_order_relaxed);
+
+  return count;
+}
+
+template <typename Data>
+stream_connector_pool::Response stream_connector_pool::send_request(const Data& packet, int send_flags, float timeout, Channel** sent_channel, uint32_t* sent_request_id)
+{
+  std::promise<rs::Packet> promise;
+  auto                     response = promise.get_future();
+
+  auto channel = select_channel();
+  if (channel == nullptr)
+  {
+    promise.set_exception(std::make_exception_ptr(rs::exception("not connected to server")));
+    return response;
+  }
+
+  std::lock_guard<std::mutex> send_locker(channel->send_mutex);
+
+  // 선택 후 끊어진 경우 (재접속은 receive thread가 한다)
+  if (channel->connector.isConnected() == false)
+  {
+    promise.set_exception(std::make_exception_ptr(rs::exception("not connected to server")));
+    return response;
+  }
+
+  const uint32_t request_id = next_request_id();
+  packet.updateRequestId(request_id);
+
+  // 응답 대기 만료
+  Request request = { std::move(promise) };
+
+  if (timeout <= 0)
+    timeout = arguments_.request_timeout;
+
+  if (timeout > 0)
+    request.deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(timeout));
+
+  // 응답이 전송 완료 전에 도착할 수 있으므로 먼저 등록한다
+  {
+    std::lock_guard<std::mutex> locker(channel->mutex);
+    channel->requests.emplace(request_id, std::move(request));
+    channel->inflight++;
+  }
+
+  if (sent_channel != nullptr)
+    *sent_channel = channel;
+  if (sent_request_id != nullptr)
+    *sent_request_id = request_id;
+
+  if (channel->connector.send(packet, send_flags, 0) <= 0)
+  {
+    std::string reason = "send : " + std::string(channel->connector.error() ? channel->connector.error() : "");
+
+    std::lock_guard<std::mutex> locker(channel->mutex);
+
+    auto iter = channel->requests.find(request_id);
+    if (iter != channel->requests.end())
+    {
+      iter->second.promise.set_exception(std::make_exception_ptr(rs::exception(reason)));
+      channel->requests.erase(iter);
+      channel->inflight--;
+    }
+  }
+
+  return response;
+}
+
+stream_connector_pool::Channel* stream_connector_pool::select_channel()
+{
+  if (stop_ || channels_.empty())
+    return nullptr;
+
+  // 응답 대기 중인 요청이 가장 적은 connection (같으면 round robin)
+  const size_t count = channels_.size();
+  const size_t first = round_.fetch_add(1, std::memory_order_relaxed);
+
+  Channel* selected = nullptr;
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    auto channel = channels_[(first + i) % count].get();
+    if (channel->connector.isConnected() == false)
+      continue;
+
+    if (selected == nullptr || channel->inflight.load(std::memory_order_relaxed) < selected->inflight.load(std::memory_order_relaxed))
+      selected = channel;
+  }
+
+  return selected;
+}
+
+uint32_t stream_connector_pool::next_request_id()
+{
+  uint32_t request_id = ++request_id_;
+
+  // 0 (Packet::UNDEFINED_REQUEST)은 사용하지 않는다
+  if (request_id == 0)
+    request_id = ++request_id_;
+
+  return request_id;
+}
+
+void stream_connector_pool::onReceiveMessage(Channel* channel)
+{
+  // 수신 버퍼는 한 번만 할당한다
+  std::vector<uint8_t>  buffer(arguments_.recv_buffer_size);
+  PacketReceiver::Spans packets;
+
+  const auto reconnect_interval = std::chrono::duration<float>(std::max(arguments_.reconnect_interval, 0.01f));
+  const auto expire_interval    = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(EXPIRE_INTERVAL));
+
+  auto expire_time = std::chrono::steady_clock::now() + expire_interval;
+
+  while (stop_ == false)
+  {
+    // 응답이 오지 않은 요청
+    if (std::chrono::steady_clock::now() >= expire_time)
+    {
+      expire_requests(*channel);
+      expire_time = std::chrono::steady_clock::now() + expire_interval;
+    }
+
+    // reconnection
+    if (channel->connector.isConnected() == false)
+    {
+      std::this_thread::sleep_for(reconnect_interval);
+
+      std::lock_guard<std::mutex> send_locker(channel->send_mutex);
+
+      if (stop_ == false && channel->connector.connect(server_address_, server_port_, arguments_.connector))
+        channel->receiver.clear();
+
+      continue;
+    }
+
+    ssize_t recv_size = ::recv(channel->connector.socket().id(), buffer.data(), buffer.size(), 0);
+
+    // disconnect()의 shutdown
+    if (stop_)
+      break;
+
+    if (recv_size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+      continue;
+
+    if (recv_size <= 0)
+    {
+      std::string reason = recv_size == 0 ? "connection closed" : "recv : " + std::string(::strerror(errno));
+
+      std::lock_guard<std::mutex> send_locker(channel->send_mutex);
+
+      channel->connector.disconnect();
+      fail_requests(*channel, reason);
+      continue;
+    }
+
+    channel->receiver.store_and_drain(buffer.data(), recv_size, packets);
+
+    for (const auto& packet : packets)
+    {
+      const uint32_t request_id = reinterpret_cast<const Packet::Header*>(packet.data)->data.request_id;
+
+      std::promise<rs::Packet> promise;
+
+      {
+        std::lock_guard<std::mutex> locker(channel->mutex);
+
+        // 요청하지 않은 패킷은 버린다
+        auto iter = channel->requests.find(request_id);
+        if (iter == channel->requests.end())
+          continue;
+
+        promise = std::move(iter->second.promise);
+        channel->requests.erase(iter);
+        channel->inflight--;
+      }
+
+      promise.set_value(rs::Packet(packet.data, packet.size));
+    }
+  }
+}
+
+void stream_connector_pool::cancel_request(Channel& channel, uint32_t request_id)
+{
+  std::lock_guard<std::mutex> locker(channel.mutex);
+
+  // 이미 응답을 받았거나 실패한 요청
+  if (channel.requests.erase(request_id) > 0)
+    channel.inflight--;
+}
+
+void stream_connector_pool::fail_requests(Channel& channel, const std::string& reason)
+{
+  std::unordered_map<uint32_t, Request> requests;
+
+  {
+    std::lock_guard<std::mutex> locker(channel.mutex);
+    requests.swap(channel.requests);
+    channel.inflight = 0;
+  }
+
+  for (auto& [request_id, request] : requests)
+    request.promise.set_exception(std::make_exception_ptr(rs::exception(reason)));
+}
+
+void stream_connector_pool::expire_requests(Channel& channel)
+{
+  std::vector<std::promise<rs::Packet>> expired;
+
+  {
+    std::lock_guard<std::mutex> locker(channel.mutex);
+
+    const auto now = std::chrono::steady_clock::now();
+
+    for (auto iter = channel.requests.begin(); iter != channel.requests.end();)
+    {
+      if (iter->second.deadline > now)
+      {
+        ++iter;
+        continue;
+      }
+
+      expired.push_back(std::move(iter->second.promise));
+      iter = channel.requests.erase(iter);
+      channel.inflight--;
+    }
+  }
+
+  for (auto& promise : expired)
+    promise.set_exception(std::make_exception_ptr(rs::exception("receive timeout")));
+}
+
+void stream_connector_pool::set_error(const std::string& error)
+{
+  std::lock_guard<std::mutex> locker(error_mutex_);
+  error_ = error;
+}
+
+};  // namespace network
+};  // namespace rs
@@ -1,9 +1,30 @@
+#include <algorithm>
 #include <rowen/core/exception.hpp>
 #include <rowen/network/listener_dgram.hpp>
 
 namespace rs {
 namespace network {
 
+namespace {
+
+// UDP GRO segment size of received message (0 : not coalesced)
+size_t gro_segment_size(const struct msghdr& message)
+{
+  for (auto cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr; cmsg = CMSG_NXTHDR(const_cast<struct msghdr*>(&message), cmsg))
+  {
+    if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO)
+    {
+      int segment_size = 0;
+      ::memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+      return segment_size > 0 ? segment_size : 0;
+    }
+  }
+
+  return 0;
+}
+
+}  // namespace
+
 const dgram_listener::argument dgram_listener::default_arguments_ = {};
 
 bool dgram_listener::running(int port, const argument& args)
@@ -13,7 +34,7 @@ bool dgram_listener::running(int port, const argument& args)
     std::lock_guard<std::mutex> locker(listener_lock_);
 
     // create socket
-    if (socket_.open(SOCK_DGRAM, args.socket_protocol) == false)
+    if (socket_.open(SOCK_DGRAM, args.socket_protocol, args.socket_family) == false)
       throw rs::exception("open socket : " + socket_.error());
 
     // set socket option : reuse address
@@ -54,6 +75,14 @@ bool dgram_listener::running(int port, const argument& args)
     if (socket_.setSendTimeout(args.listener_send_timeout) == false)
       throw rs::exception("set send_timeout : " + socket_.error());
 
+    // set socket option : UDP GRO
+    if (args.listener_recv_gro)
+    {
+      int gro = 1;
+      if (socket_.setOption(SOL_UDP, UDP_GRO, &gro, sizeof(gro)) == false)
+        throw rs::exception("set udp_gro : " + socket_.error());
+    }
+
     // bind socket
     if (socket_.bind(port) == false)
       throw rs::exception("bind socket : " + socket_.error());
@@ -67,7 +96,7 @@ bool dgram_listener::running(int port, const argument& args)
     socket_.close();
 
     // set last error
-    error_ = e.what();
+    set_error(e.what());
     return false;
   }
 
@@ -79,16 +108,25 @@ ssize_t dgram_listener::send(const uint8_t*            data,
                              const struct sockaddr_in& addr,
                              const socklen_t           addr_len,
                              int                       send_flags)
+{
+  return send(data, size, reinterpret_cast<const struct sockaddr*>(&addr), addr_len, send_flags);
+}
+
+ssize_t dgram_listener::send(const uint8_t*         data,
+                             const size_t           size,
+                             const struct sockaddr* addr,
+                             const socklen_t        addr_len,
+                             int                    send_flags)
 {
   ssize_t res = 0;
 
   {
     std::lock_guard<std::mutex> locker(listener_lock_);
-    res = socket_.send(data, size, send_flags, (const struct sockaddr*)&addr, addr_len);
+    res = socket_.send(data, size, send_flags, addr, addr_len);
   }
 
   if (res <= 0)
-    error_ = socket_.error();
+    set_error(socket_.error());
 
   return res;
 }
@@ -105,88 +143,179 @@ ssize_t dgram_listener::send(const rs::Packet&         packet,
 
 std::string dgram_listener::client_address(const struct sockaddr* addr, socklen_t addr_len)
 {
-  if (addr == nullptr)
+  if (addr == nullptr || addr_len < static_cast<socklen_t>(sizeof(sa_family_t)))
     return "";
 
-  char buffer[INET6_ADDRSTRLEN] = {};
-
-  if (addr->sa_family == AF_INET)
-  {
-    auto addr_in = reinterpret_cast<const struct sockaddr_in*>(addr);
-    inet_ntop(AF_INET, &addr_in->sin_addr, buffer, INET_ADDRSTRLEN);
-  }
-  else if (addr->sa_family == AF_INET6)
-  {
-    auto addr_in6 = reinterpret_cast<const struct sockaddr_in6*>(addr);
-    inet_ntop(AF_INET6, &addr_in6->sin6_addr, buffer, INET6_ADDRSTRLEN);
-  }
-
-  return buffer;
+  return address_to_string(addr);
 }
 
 void dgram_listener::onReceiveMessage(const argument& args)
 {
   receiver_stop_ = false;
 
+  if (args.listener_recv_batch_size > 0 || args.listener_recv_gro)
+  {
+    onReceiveMessageBatch(args);
+    return;
+  }
+
   // timeout (restrict infinite timeout)
   float timeout_sec = args.listener_select_timeout;
   if (timeout_sec < 0.01)
     timeout_sec = 0.5;
 
+  // 수신 버퍼는 한 번만 할당해서 재사용한다
+  auto buffer = std::make_unique<uint8_t[]>(args.listener_recv_max_size);
+
   while (receiver_stop_ == false)
   {
-    // init fd_set
-    fd_set read_fds;
-    FD_ZERO(&read_fds);
+    if (wait_readable(timeout_sec) == false)
+      continue;
 
-    // add our descriptors to the set
-    FD_SET(socket_.id(), &read_fds);
+    struct sockaddr_storage client_addr     = {};
+    socklen_t               client_addr_len = sizeof(client_addr);
 
-    // wait until either socket has data ready to be recv()
-    timeval timeout  = float_to_timeval(timeout_sec);
-    auto    activity = ::select(socket_.id() + 1, &read_fds, NULL, NULL, &timeout);
-    if (activity < 0)
+    ssize_t recv_len = socket_.recv(buffer.get(),
+                                    args.listener_recv_max_size,
+                                    args.listener_recv_flags,
+                                    (struct sockaddr*)&client_addr,
+                                    &client_addr_len);
+
+    if (recv_len <= 0)
     {
-      error_ = "select error : " + std::string(::strerror(errno));
       continue;
     }
+    else if (callback_received_)
+    {
+      callback_received_(buffer.get(),
+                         recv_len,
+                         reinterpret_cast<const sockaddr*>(&client_addr),
+                         client_addr_len);
+    }
+  }
+}
 
-    if (activity == 0)  // timeout
+void dgram_listener::onReceiveMessageBatch(const argument& args)
+{
+  // timeout (restrict infinite timeout)
+  float timeout_sec = args.listener_select_timeout;
+  if (timeout_sec < 0.01)
+    timeout_sec = 0.5;
+
+  const size_t batch_size  = std::max(args.listener_recv_batch_size, 1);
+  const size_t buffer_size = args.listener_recv_gro ? std::max(args.listener_recv_max_size, MAX_UDP_PAYLOAD_SIZE) : args.listener_recv_max_size;
+
+  // UDP GRO segment size (control message)
+  constexpr size_t CONTROL_SIZE = CMSG_SPACE(sizeof(int));
+
+  // buffer ring : batch_size 개의 수신 버퍼와 recvmmsg header를 한 번만 할당한다
+  auto buffers   = std::make_unique<uint8_t[]>(batch_size * buffer_size);
+  auto messages  = std::make_unique<struct mmsghdr[]>(batch_size);
+  auto vectors   = std::make_unique<struct iovec[]>(batch_size);
+  auto addresses = std::make_unique<struct sockaddr_storage[]>(batch_size);
+  auto controls  = std::make_unique<uint8_t[]>(batch_size * CONTROL_SIZE);
+  auto datagrams = std::make_unique<Datagram[]>(batch_size);
+
+  for (size_t i = 0; i < batch_size; ++i)
+  {
+    vectors[i].iov_base = buffers.get() + i * buffer_size;
+    vectors[i].iov_len  = buffer_size;
+
+    messages[i]                    = {};
+    messages[i].msg_hdr.msg_iov    = &vectors[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+    messages[i].msg_hdr.msg_name   = &addresses[i];
+  }
+
+  const int recv_flags = args.listener_recv_flags | MSG_DONTWAIT;
+
+  while (receiver_stop_ == false)
+  {
+    if (wait_readable(timeout_sec) == false)
       continue;
 
-    if (FD_ISSET(socket_.id(), &read_fds))
+    // 준비된 datagram이 남아있지 않을 때까지 (batch가 가득 차지 않을 때까지) 수신한다
+    int recv_count = 0;
+    do
     {
-      struct sockaddr_in client_addr     = {};
-      socklen_t          client_addr_len = sizeof(client_addr);
+      for (size_t i = 0; i < batch_size; ++i)
+      {
+        messages[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
 
-      auto buffer = std::make_unique<uint8_t[]>(args.listener_recv_max_size);
-      memset(buffer.get(), 0, args.listener_recv_max_size);
+        if (args.listener_recv_gro)
+        {
+          messages[i].msg_hdr.msg_control    = controls.get() + i * CONTROL_SIZE;
+          messages[i].msg_hdr.msg_controllen = CONTROL_SIZE;
+        }
+      }
 
-      ssize_t recv_len = -1;
+      recv_count = socket_.recvBatch(messages.get(), batch_size, recv_flags);
+      if (recv_count < 0)
+      {
+        set_error("recv batch error : " + socket_.error());
+        break;
+      }
 
+      for (int i = 0; i < recv_count; ++i)
       {
-        recv_len = socket_.recv(buffer.get(),
-                                args.listener_recv_max_size,
-                                args.listener_recv_flags,
-                                (struct sockaddr*)&client_addr,
-                                &client_addr_len);
+        datagrams[i].data         = buffers.get() + i * buffer_size;
+        datagrams[i].size         = messages[i].msg_len;
+        datagrams[i].addr         = reinterpret_cast<const sockaddr*>(&addresses[i]);
+        datagrams[i].addr_len     = messages[i].msg_hdr.msg_namelen;
+        datagrams[i].segment_size = args.listener_recv_gro ? gro_segment_size(messages[i].msg_hdr) : 0;
       }
 
-      if (recv_len <= 0)
+      if (callback_received_batch_)
       {
-        continue;
+        if (recv_count > 0)
+          callback_received_batch_(datagrams.get(), recv_count);
       }
       else if (callback_received_)
       {
-        callback_received_(buffer.get(),
-                           recv_len,
-                           reinterpret_cast<const sockaddr*>(&client_addr),
-                           client_addr_len);
+        for (int i = 0; i < recv_count; ++i)
+        {
+          auto& datagram = datagrams[i];
+
+          // 합쳐진 buffer는 segment 단위로 나누어 전달한다
+          size_t segment_size = datagram.segment_size > 0 ? datagram.segment_size : datagram.size;
+
+          for (size_t offset = 0; offset < datagram.size; offset += segment_size)
+          {
+            callback_received_(datagram.data + offset,
+                               std::min(segment_size, datagram.size - offset),
+                               datagram.addr,
+                               datagram.addr_len);
+          }
+        }
       }
-    }
+    } while (recv_count == static_cast<int>(batch_size) && receiver_stop_ == false);
   }
 }
 
+bool dgram_listener::wait_readable(float timeout_sec)
+{
+  // init fd_set
+  fd_set read_fds;
+  FD_ZERO(&read_fds);
+
+  // add our descriptors to the set
+  FD_SET(socket_.id(), &read_fds);
+
+  // wait until either socket has data ready to be recv()
+  timeval timeout  = float_to_timeval(timeout_sec);
+  auto    activity = ::select(socket_.id() + 1, &read_fds, NULL, NULL, &timeout);
+  if (activity < 0)
+  {
+    set_error("select error : " + std::string(::strerror(errno)));
+    return false;
+  }
+
+  if (activity == 0)  // timeout
+    return false;
+
+  return FD_ISSET(socket_.id(), &read_fds);
+}
+
 void dgram_listener::attachReceivedCallback(const OnReceivedCallback& callback)
 {
   std::lock_guard<std::mutex> locker(listener_lock_);
@@ -194,5 +323,12 @@ void dgram_listener::attachReceivedCallback(const OnReceivedCallback& callback)
   callback_received_ = callback;
 }
 
+void dgram_listener::attachReceivedBatchCallback(const OnReceivedBatchCallback& callback)
+{
+  std::lock_guard<std::mutex> locker(listener_lock_);
+
+  callback_received_batch_ = callback;
+}
+
 }  // namespace network
 }  // namespace rs
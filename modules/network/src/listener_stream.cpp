@@ -1,3 +1,11 @@
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include <algorithm>
 #include <iomanip>
 #include <rowen/core/exception.hpp>
 #include <rowen/network/listener_stream.hpp>
@@ -8,61 +16,246 @@ namespace network {
 
 const stream_listener::argument stream_listener::default_arguments_ = {};
 
-bool stream_listener::running(int port, const argument& args)
+namespace {
+
+// io_uring user_data (session 주소는 8 byte 정렬이므로 하위 2 bit로 요청을 구분한다)
+constexpr uint64_t URING_ACCEPT   = 0;  // listener socket
+constexpr uint64_t URING_WAKEUP   = 1;  // eventfd (writable 대기 요청)
+constexpr uint64_t URING_WRITABLE = 2;  // (client socket << 2) | URING_WRITABLE
+constexpr uint64_t URING_IGNORE   = 3;  // cancel
+constexpr uint64_t URING_TAG_MASK = 3;
+
+// writable event 한 번에 전송하는 최대 output queue 메시지 수
+constexpr int MAX_FLUSH_IOV = 64;
+
+bool is_connection_error(int error)
+{
+  // 재접속이 필요한 경우와 관련된 에러 코드
+  return error == EPIPE ||
+         error == ECONNABORTED ||
+         error == ECONNREFUSED ||
+         error == ETIMEDOUT ||
+         error == ENETRESET ||
+         error == ECONNRESET ||
+         error == ENOTCONN ||
+         error == ENETDOWN ||
+         error == EHOSTDOWN ||
+         error == EHOSTUNREACH;
+}
+
+}  // namespace
+
+bool stream_listener::running(int port, const argument& arguments)
 {
+  // io_uring을 지원하지 않는 kernel은 epoll로 대체한다
+  argument args = arguments;
+  if (args.listener_backend == backend::io_uring && Uring::supported() == false)
+    args.listener_backend = backend::epoll;
+
   try
   {
     std::lock_guard<std::mutex> locker(listener_lock_);
 
-    // create socket
-    if (socket_.open(SOCK_STREAM, args.socket_protocol) == false)
-      throw rs::exception("open socket : " + socket_.error());
+    active_backend_ = args.listener_backend;
+    arguments_      = args;
 
-    // set socket option : reuse address
-    {
-      int reuse_address = args.reuse_address ? 1 : 0;
-      if (socket_.setOption(SOL_SOCKET, SO_REUSEADDR, &reuse_address, sizeof(reuse_address)) == false)
-        throw rs::exception("set reuse_addr : " + socket_.error());
-    }
+    // reactor (select backend는 하나의 thread만 사용한다)
+    int reactor_count = args.listener_backend != backend::select ? std::max(args.listener_reactors, 1) : 1;
 
-    // set socket option : reuse port
+    reactors_.clear();
+    for (int i = 0; i < reactor_count; ++i)
     {
-      int reuse_port = args.reuse_port ? 1 : 0;
-      if (socket_.setOption(SOL_SOCKET, SO_REUSEPORT, &reuse_port, sizeof(reuse_port)) == false)
-        throw rs::exception("set reuse_port : " + socket_.error());
+      auto reactor    = std::make_unique<Reactor>();
+      reactor->index  = i;
+      reactor->socket = (i == 0) ? &socket_ : &reactor->listen_socket;
+      reactors_.push_back(std::move(reactor));
     }
 
-    // set socket option : recv timeout
-    if (socket_.setReceiveTimeout(args.listener_recv_timeout) == false)
-      throw rs::exception("set recv_timeout : " + socket_.error());
-
-    // bind socket
-    if (socket_.bind(port) == false)
-      throw rs::exception("bind socket : " + socket_.error());
+    for (auto& reactor : reactors_)
+    {
+      // port 0 : reactor 0이 할당 받은 port를 공유한다
+      int reactor_port = port;
+      if (port == 0 && reactor->index > 0)
+        reactor_port = socket_.port();
 
-    // Listen for incoming connections
-    if (socket_.listen(args.backlog) == false)
-      throw rs::exception("listen : " + socket_.error());
+      open_reactor(*reactor, reactor_port, args);
+    }
 
     // running listener
-    receiver_ = std::async(std::launch::async, &stream_listener::onReceiveMessage, this, args);
+    receiver_stop_ = false;
+
+    for (auto& reactor : reactors_)
+    {
+      if (args.listener_backend == backend::io_uring)
+        reactor->worker = std::async(std::launch::async, &stream_listener::onReceiveMessageUring, this, reactor.get(), args);
+      else if (args.listener_backend == backend::epoll)
+        reactor->worker = std::async(std::launch::async, &stream_listener::onReceiveMessageEpoll, this, reactor.get(), args);
+      else
+        reactor->worker = std::async(std::launch::async, &stream_listener::onReceiveMessage, this, reactor.get(), args);
+    }
   }
   catch (const rs::exception& e)
   {
     // release socket
-    socket_.close();
+    for (auto& reactor : reactors_)
+      close_reactor(*reactor);
 
     // set last error
-    error_ = e.what();
+    set_error(e.what());
     return false;
   }
 
   return true;
 }
 
-void stream_listener::onReceiveMessage(const argument& args)
+stream_listener::~stream_listener()
+{
+  stop();
+}
+
+void stream_listener::stop()
 {
-  receiver_stop_ = false;
+  // reactor thread를 먼저 종료한 뒤 socket을 닫는다
+  {
+    std::lock_guard<std::mutex> locker(listener_lock_);
+
+    receiver_stop_ = true;
+    for (auto& reactor : reactors_)
+      if (reactor->worker.valid())
+        reactor->worker.wait();
+  }
+
+  template_listener::stop();
+
+  {
+    std::lock_guard<std::mutex> locker(listener_lock_);
+
+    for (auto& reactor : reactors_)
+      close_reactor(*reactor);
+  }
+}
+
+void stream_listener::open_reactor(Reactor& reactor, int port, const argument& args)
+{
+  auto& socket = *reactor.socket;
+
+  // create socket
+  if (socket.open(SOCK_STREAM, args.socket_protocol, args.socket_family) == false)
+    throw rs::exception("open socket : " + socket.error());
+
+  // set socket option : reuse address
+  {
+    int reuse_address = args.reuse_address ? 1 : 0;
+    if (socket.setOption(SOL_SOCKET, SO_REUSEADDR, &reuse_address, sizeof(reuse_address)) == false)
+      throw rs::exception("set reuse_addr : " + socket.error());
+  }
+
+  // set socket option : reuse port (reactor가 여러 개인 경우 같은 port에 bind 해야 한다)
+  {
+    int reuse_port = (args.reuse_port || reactors_.size() > 1) ? 1 : 0;
+    if (socket.setOption(SOL_SOCKET, SO_REUSEPORT, &reuse_port, sizeof(reuse_port)) == false)
+      throw rs::exception("set reuse_port : " + socket.error());
+  }
+
+  // set socket option : recv timeout
+  if (socket.setReceiveTimeout(args.listener_recv_timeout) == false)
+    throw rs::exception("set recv_timeout : " + socket.error());
+
+  // bind socket
+  if (socket.bind(port) == false)
+    throw rs::exception("bind socket : " + socket.error());
+
+  // Listen for incoming connections
+  if (socket.listen(args.backlog) == false)
+    throw rs::exception("listen : " + socket.error());
+
+  // create epoll instance (listener socket is non-blocking for edge-triggered accept)
+  if (args.listener_backend == backend::epoll)
+  {
+    reactor.epoll_handle = ::epoll_create1(EPOLL_CLOEXEC);
+    if (reactor.epoll_handle == INVALID_SOCKET)
+      throw rs::exception("epoll_create : " + std::string(::strerror(errno)));
+
+    if (::fcntl(socket.id(), F_SETFL, ::fcntl(socket.id(), F_GETFL, 0) | O_NONBLOCK) == -1)
+      throw rs::exception("set non-blocking : " + std::string(::strerror(errno)));
+
+    struct epoll_event event = {};
+    event.events             = EPOLLIN | EPOLLET;
+    event.data.ptr           = nullptr;  // listener socket
+
+    if (::epoll_ctl(reactor.epoll_handle, EPOLL_CTL_ADD, socket.id(), &event) == -1)
+      throw rs::exception("epoll_ctl : " + std::string(::strerror(errno)));
+  }
+
+  // create io_uring instance & provided buffer ring (buffer 수는 2의 거듭제곱)
+  if (args.listener_backend == backend::io_uring)
+  {
+    reactor.uring = std::make_unique<Uring>();
+    if (reactor.uring->open(std::max(args.listener_max_events, 8)) == false)
+      throw rs::exception("io_uring setup : " + std::string(::strerror(errno)));
+
+    unsigned buffer_count = 1;
+    while (buffer_count < static_cast<unsigned>(std::max(args.listener_uring_buffers, 1)) && buffer_count < 32768)
+      buffer_count <<= 1;
+
+    if (reactor.uring->registerBuffers(0, buffer_count, std::max(args.listener_buffer_size, 1)) == false)
+      throw rs::exception("io_uring buffer ring : " + std::string(::strerror(errno)));
+
+    // 다른 thread의 send()가 writable 대기를 요청할 때 reactor를 깨운다
+    reactor.event_handle = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (reactor.event_handle == INVALID_SOCKET)
+      throw rs::exception("eventfd : " + std::string(::strerror(errno)));
+  }
+}
+
+void stream_listener::close_reactor(Reactor& reactor)
+{
+  if (reactor.socket != nullptr)
+    reactor.socket->close();
+
+  if (reactor.epoll_handle != INVALID_SOCKET)
+  {
+    ::close(reactor.epoll_handle);
+    reactor.epoll_handle = INVALID_SOCKET;
+  }
+
+  // ring을 닫으면 진행 중인 accept, recv 요청이 취소된다
+  reactor.uring = nullptr;
+
+  if (reactor.event_handle != INVALID_SOCKET)
+  {
+    ::close(reactor.event_handle);
+    reactor.event_handle = INVALID_SOCKET;
+  }
+}
+
+void stream_listener::pin_reactor(const Reactor& reactor, const argument& args)
+{
+  if (args.listener_reactor_affinity.empty())
+    return;
+
+  int cpu = args.listener_reactor_affinity[reactor.index % args.listener_reactor_affinity.size()];
+  if (cpu < 0 || cpu >= CPU_SETSIZE)
+  {
+    set_error("invalid reactor affinity : " + std::to_string(cpu));
+    return;
+  }
+
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpu, &cpu_set);
+
+  int res = ::pthread_setaffinity_np(::pthread_self(), sizeof(cpu_set), &cpu_set);
+  if (res != 0)
+    set_error("set reactor affinity : " + std::string(::strerror(res)));
+}
+
+void stream_listener::onReceiveMessage(Reactor* reactor, const argument& args)
+{
+  pin_reactor(*reactor, args);
+
+  auto& socket   = *reactor->socket;
+  auto& sessions = reactor->sessions;
 
   // timeout (restrict infinite timeout)
   float timeout_sec = args.listener_select_timeout;
@@ -76,14 +269,14 @@ void stream_listener::onReceiveMessage(const argument& args)
     FD_ZERO(&read_fds);
 
     // add our descriptors to the set
-    FD_SET(socket_.id(), &read_fds);
-    int fd_max = socket_.id();
+    FD_SET(socket.id(), &read_fds);
+    int fd_max = socket.id();
 
-    for (const auto& [_, client] : connected_clients_)
+    for (const auto& [client_socket, _] : sessions)
     {
-      FD_SET(client.client_socket.id(), &read_fds);
-      if (client.client_socket.id() > fd_max)
-        fd_max = client.client_socket.id();
+      FD_SET(client_socket, &read_fds);
+      if (client_socket > fd_max)
+        fd_max = client_socket;
     }
 
     // wait until either socket has data ready to be recv()
@@ -91,7 +284,7 @@ void stream_listener::onReceiveMessage(const argument& args)
     int     activity = ::select(fd_max + 1, &read_fds, NULL, NULL, &timeout);
     if (activity < 0)
     {
-      error_ = "select error : " + std::string(::strerror(errno));
+      set_error("select error : " + std::string(::strerror(errno)));
       continue;
     }
 
@@ -99,173 +292,507 @@ void stream_listener::onReceiveMessage(const argument& args)
       continue;
 
     // If something happened on the master socket, then its an incoming connection
-    if (FD_ISSET(socket_.id(), &read_fds))
+    if (FD_ISSET(socket.id(), &read_fds))
+      accept_client(*reactor, args);
+
+    auto iter = sessions.begin();
+    while (iter != sessions.end())
     {
-      auto accepted_socket = socket_.accept();
+      auto  client        = iter->second.client;
+      auto& client_socket = client->client_socket;
 
-      if (accepted_socket.valid() == false)
+      if (FD_ISSET(client_socket.id(), &read_fds) == false)
       {
-        error_ = "accept error : " + socket_.error();
+        ++iter;
         continue;
       }
 
-      // add the new socket to the connected_clients_
-      const Client* new_client = nullptr;
+      // Receive data & Check client disconnection (session 수신 버퍼 재사용)
+      auto&   session   = iter->second;
+      auto&   buffer    = session.buffer;
+      ssize_t recv_size = -1;
 
       {
-        std::lock_guard<std::mutex> locker(connected_clients_mutex_);
+        std::lock_guard<std::mutex> locker(reactor->mutex);
 
-        // add new client
-        if (connected_clients_.find(accepted_socket.id()) != connected_clients_.end())
-        {
-          error_ = "already connected client : " + std::to_string(accepted_socket.id());
-          continue;
-        }
+        recv_size = client_socket.recv(buffer.data(), buffer.size(), args.client_recv_flags);
+      }
+
+      if (recv_size == 0)
+      {
+        // client disconnected (remove_client()가 iter를 무효화하므로 먼저 다음 위치로 이동한다)
+        auto client_socket_id = (iter++)->first;
+        remove_client(*reactor, client_socket_id, args);
+        continue;
+      }
+      else if (recv_size < 0)
+      {
+        set_error("recv error : " + std::string(::strerror(errno)));
+      }
+      else
+      {
+        deliver(session, buffer.data(), recv_size, args);
+      }
+
+      ++iter;
+    }
+  }
+}
+
+void stream_listener::onReceiveMessageEpoll(Reactor* reactor, const argument& args)
+{
+  pin_reactor(*reactor, args);
+
+  // timeout (restrict infinite timeout)
+  float timeout_sec = args.listener_select_timeout;
+  if (timeout_sec < 0.01)
+    timeout_sec = 0.5;
+
+  const int timeout_ms = static_cast<int>(timeout_sec * 1000);
+
+  std::vector<struct epoll_event> events(std::max(args.listener_max_events, 1));
+
+  while (receiver_stop_ == false)
+  {
+    int activity = ::epoll_wait(reactor->epoll_handle, events.data(), static_cast<int>(events.size()), timeout_ms);
+    if (activity < 0)
+    {
+      if (errno != EINTR)
+        set_error("epoll_wait error : " + std::string(::strerror(errno)));
+      continue;
+    }
+
+    for (int i = 0; i < activity; ++i)
+    {
+      auto session = static_cast<Session*>(events[i].data.ptr);
 
-        Client client;
-        client.client_socket = accepted_socket;
-        snprintf(client.client_ipaddr, sizeof(client.client_ipaddr), "%s", inet_ntoa(accepted_socket.address().sin_addr));
+      // incoming connection (edge-triggered : backlog가 빌 때까지 accept)
+      if (session == nullptr)
+      {
+        while (accept_client(*reactor, args) != nullptr)
+          ;
+        continue;
+      }
 
-        new_client = &connected_clients_.insert({ client.client_socket.id(), client }).first->second;
+      // writable : output queue 전송 (client_send_queue)
+      if (events[i].events & EPOLLOUT)
+      {
+        bool   relieved    = false;
+        size_t queued_size = 0;
 
-        if (new_client)
         {
-          new_client->client_socket.setReceiveFlags(args.client_recv_flags);
-          new_client->client_socket.setReceiveTimeout(args.client_recv_timeout);
-          new_client->client_socket.setSendFlags(args.client_send_flags);
-          new_client->client_socket.setSendTimeout(args.client_send_timeout);
-          new_client->client_socket.setSendBufferSize(args.client_buffer_size);
+          std::lock_guard<std::mutex> locker(reactor->mutex);
+          relieved    = flush_client(*reactor, *session);
+          queued_size = session->output_size;
         }
+
+        if (relieved)
+          notify_backpressure(session->client, false, queued_size);
+
+        if ((events[i].events & ~EPOLLOUT) == 0)
+          continue;
       }
 
-      // callback
-      if (callback_connected_ && new_client)
-        callback_connected_(new_client);
+      // receive data (edge-triggered : 수신 버퍼가 빌 때까지 recv)
+      if (receive_client(*session, args) == false)
+        remove_client(*reactor, session->client->client_socket.id(), args);
+    }
+  }
+}
+
+void stream_listener::onReceiveMessageUring(Reactor* reactor, const argument& args)
+{
+  pin_reactor(*reactor, args);
+
+  auto& ring = *reactor->uring;
+
+  // timeout (restrict infinite timeout)
+  float timeout_sec = args.listener_select_timeout;
+  if (timeout_sec < 0.01)
+    timeout_sec = 0.5;
+
+  const int timeout_ms = static_cast<int>(timeout_sec * 1000);
+
+  // multishot accept, writable 대기 요청 (eventfd)
+  if (ring.prepareAccept(reactor->socket->id(), URING_ACCEPT, true) == false ||
+      ring.preparePoll(reactor->event_handle, POLLIN, URING_WAKEUP, true) == false)
+  {
+    set_error("io_uring submission queue is full");
+    return;
+  }
+
+  auto on_complete = [&](const struct io_uring_cqe& cqe) {
+    const bool more = (cqe.flags & IORING_CQE_F_MORE) != 0;
+
+    // writable 대기 요청 : 요청된 client socket에 POLLOUT 등록
+    if ((cqe.user_data & URING_TAG_MASK) == URING_WAKEUP)
+    {
+      uint64_t count = 0;
+      if (::read(reactor->event_handle, &count, sizeof(count)) < 0 && errno != EAGAIN)
+        set_error("eventfd read error : " + std::string(::strerror(errno)));
 
-      // create packet collector
-      if (args.using_rs_packet)
       {
-        if (rs_packet_receiver_.find(new_client) == rs_packet_receiver_.end())
-          rs_packet_receiver_[new_client] = std::make_unique<PacketReceiver>();
+        std::lock_guard<std::mutex> locker(reactor->mutex);
+
+        for (auto client_socket : reactor->writable_requests)
+          if (ring.preparePoll(client_socket, POLLOUT, (static_cast<uint64_t>(client_socket) << 2) | URING_WRITABLE, false) == false)
+            set_error("io_uring submission queue is full");
+
+        reactor->writable_requests.clear();
       }
+
+      if (more == false && receiver_stop_ == false && ring.preparePoll(reactor->event_handle, POLLIN, URING_WAKEUP, true) == false)
+        set_error("io_uring submission queue is full");
+      return;
     }
 
-    auto iter = connected_clients_.begin();
-    while (iter != connected_clients_.end())
+    // writable : output queue 전송 (남은 데이터가 있으면 다시 POLLOUT 등록)
+    if ((cqe.user_data & URING_TAG_MASK) == URING_WRITABLE)
     {
-      auto& client_socket = iter->second.client_socket;
+      if (cqe.res < 0)  // canceled (client removed)
+        return;
+
+      auto client_socket = static_cast<int>(cqe.user_data >> 2);
+
+      const Client* client      = nullptr;
+      size_t        queued_size = 0;
 
-      if (FD_ISSET(client_socket.id(), &read_fds) == false)
       {
-        ++iter;
-        continue;
+        std::lock_guard<std::mutex> locker(reactor->mutex);
+
+        auto iter = reactor->sessions.find(client_socket);
+        if (iter == reactor->sessions.end() || iter->second.writable_wait == false)
+          return;
+
+        if (flush_client(*reactor, iter->second))
+          client = iter->second.client;
+        queued_size = iter->second.output_size;
+
+        if (iter->second.writable_wait && ring.preparePoll(client_socket, POLLOUT, cqe.user_data, false) == false)
+          set_error("io_uring submission queue is full");
       }
 
-      // Receive data & Check client disconnection
-      auto    buffer    = std::make_unique<uint8_t[]>(args.listener_buffer_size);
-      ssize_t recv_size = -1;
+      if (client != nullptr)
+        notify_backpressure(client, false, queued_size);
+      return;
+    }
 
-      {
-        std::lock_guard<std::mutex> locker(connected_clients_mutex_);
+    if (cqe.user_data == URING_IGNORE)
+      return;
 
-        recv_size = client_socket.recv(buffer.get(),
-                                       args.listener_buffer_size,
-                                       args.client_recv_flags);
+    // incoming connection
+    if (cqe.user_data == URING_ACCEPT)
+    {
+      if (cqe.res >= 0)
+        add_client(*reactor, reactor->socket->accepted(cqe.res), args);
+      else if (cqe.res != -EAGAIN && cqe.res != -ECANCELED)
+        set_error("accept error : " + std::string(::strerror(-cqe.res)));
+
+      // multishot이 종료되었다면 다시 요청한다
+      if (more == false && receiver_stop_ == false && ring.prepareAccept(reactor->socket->id(), URING_ACCEPT, true) == false)
+        set_error("io_uring submission queue is full");
+      return;
+    }
 
-        if (args.using_rs_packet && args.trace_rs_packet && recv_size > 0)
-        {
-          std::ostringstream oss;
+    auto session = reinterpret_cast<Session*>(cqe.user_data);
+    auto socket  = session->client->client_socket.id();
 
-          oss << "\033[2;36m"
-              << "[TRACE RS PACKET] received size : " << recv_size << std::endl;
+    // received data (kernel이 선택한 provided buffer. 처리 후 바로 반환한다)
+    if (cqe.res > 0 && (cqe.flags & IORING_CQE_F_BUFFER) != 0)
+    {
+      auto buffer_id = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+      deliver(*session, ring.buffer(buffer_id), cqe.res, args);
+      ring.recycle(buffer_id);
+    }
 
-          for (int i = 0; i < recv_size; ++i)
-            oss << std::hex << std::uppercase << std::setw(2) << std::setfill('0') << (unsigned int)buffer[i] << " ";
-          oss << std::endl;
+    if (more)
+      return;
 
-          oss << "[TRACE RS PACKET] end of packet"
-              << "\033[0m" << std::endl;
+    // multishot 종료 : 수신 버퍼 부족(ENOBUFS)이거나 데이터를 받은 경우는 다시 요청하고, 그 외는 연결 종료
+    if (cqe.res > 0 || cqe.res == -ENOBUFS)
+    {
+      if (ring.prepareRecv(socket, cqe.user_data, args.client_recv_flags, true))
+        return;
 
-          printf("%s", oss.str().c_str());
-        }
-      }
+      set_error("io_uring submission queue is full");
+    }
+    else if (cqe.res < 0 && cqe.res != -ECONNRESET && cqe.res != -ECANCELED)
+    {
+      set_error("recv error : " + std::string(::strerror(-cqe.res)));
+    }
 
-      if (recv_size == 0)
-      {
-        // client disconnected
-        if (callback_disconnected_)
-          callback_disconnected_(&(iter->second));
+    remove_client(*reactor, socket, args);
+  };
 
-        // remove client
-        {
-          std::lock_guard<std::mutex> locker(connected_clients_mutex_);
-          iter->second.client_socket.close();
-          iter = connected_clients_.erase(iter);
-        }
+  while (receiver_stop_ == false)
+  {
+    int res = ring.submit(1, timeout_ms);
+    if (res < 0 && res != -ETIME && res != -EINTR && res != -EBUSY)
+      set_error("io_uring_enter error : " + std::string(::strerror(-res)));
 
-        // remove packet collector
-        if (args.using_rs_packet)
-        {
-          auto packet_iter = rs_packet_receiver_.find(&(iter->second));
-          if (packet_iter != rs_packet_receiver_.end())
-            rs_packet_receiver_.erase(packet_iter);
-        }
+    ring.drain(on_complete);
+  }
+}
 
+const stream_listener::Client* stream_listener::accept_client(Reactor& reactor, const argument& args)
+{
+  auto accepted_socket = reactor.socket->accept();
+
+  if (accepted_socket.valid() == false)
+  {
+    // non-blocking listener (epoll) : 대기 중인 연결이 없음
+    if (errno != EAGAIN && errno != EWOULDBLOCK)
+      set_error("accept error : " + reactor.socket->error());
+    return nullptr;
+  }
+
+  // select()는 FD_SETSIZE 이상의 socket을 다룰 수 없다
+  if (args.listener_backend == backend::select && accepted_socket.id() >= FD_SETSIZE)
+  {
+    set_error("too many clients for select backend : " + std::to_string(accepted_socket.id()));
+    accepted_socket.close();
+    return nullptr;
+  }
+
+  return add_client(reactor, accepted_socket, args);
+}
+
+const stream_listener::Client* stream_listener::add_client(Reactor& reactor, class Socket accepted_socket, const argument& args)
+{
+  // add the new socket to the connected_clients_
+  const Client* new_client = nullptr;
+
+  {
+    std::lock_guard<std::mutex> locker(connected_clients_mutex_);
+
+    // add new client
+    if (connected_clients_.find(accepted_socket.id()) != connected_clients_.end())
+    {
+      set_error("already connected client : " + std::to_string(accepted_socket.id()));
+      return nullptr;
+    }
+
+    Client client;
+    client.client_socket = accepted_socket;
+    client.reactor       = reactor.index;
+    snprintf(client.client_ipaddr, sizeof(client.client_ipaddr), "%s", accepted_socket.ipaddress().c_str());
+    client.client_port = accepted_socket.port();
+
+    new_client = &connected_clients_.insert({ client.client_socket.id(), client }).first->second;
+  }
+
+  new_client->client_socket.setReceiveFlags(args.client_recv_flags);
+  new_client->client_socket.setReceiveTimeout(args.client_recv_timeout);
+  new_client->client_socket.setSendFlags(args.client_send_flags);
+  new_client->client_socket.setSendTimeout(args.client_send_timeout);
+  new_client->client_socket.setSendBufferSize(args.client_buffer_size);
+
+  // TCP profile (실패한 option은 kernel 기본값 유지)
+  if (new_client->client_socket.applyTcpProfile(args.client_tcp_profile) == false)
+    set_error("tcp profile : " + new_client->client_socket.error());
+
+  // create session (receive buffer, packet collector)
+  Session* new_session = nullptr;
+
+  {
+    std::lock_guard<std::mutex> locker(reactor.mutex);
+
+    new_session         = &reactor.sessions[accepted_socket.id()];
+    new_session->client = new_client;
+
+    if (args.listener_backend != backend::io_uring)
+      new_session->buffer.resize(std::max(args.listener_buffer_size, 1));
+
+    if (args.using_rs_packet)
+    {
+      new_session->receiver = std::make_unique<PacketReceiver>();
+      new_session->receiver->setVerifyChecksum(args.verify_rs_packet);
+    }
+  }
+
+  // register interest (epoll)
+  if (args.listener_backend == backend::epoll)
+  {
+    // session은 제거되기 전까지 주소가 유지된다 (unordered_map node)
+    struct epoll_event event = {};
+    event.events             = EPOLLIN | EPOLLRDHUP | EPOLLET;
+    event.data.ptr           = new_session;
+
+    if (::epoll_ctl(reactor.epoll_handle, EPOLL_CTL_ADD, accepted_socket.id(), &event) == -1)
+    {
+      set_error("epoll_ctl error : " + std::string(::strerror(errno)));
+      remove_client(reactor, accepted_socket.id(), args);
+      return nullptr;
+    }
+  }
+
+  // multishot recv (io_uring. 다음 submit에서 제출된다)
+  if (args.listener_backend == backend::io_uring)
+  {
+    if (reactor.uring->prepareRecv(accepted_socket.id(), reinterpret_cast<uint64_t>(new_session), args.client_recv_flags, true) == false)
+    {
+      set_error("io_uring submission queue is full");
+      remove_client(reactor, accepted_socket.id(), args);
+      return nullptr;
+    }
+  }
+
+  // callback
+  if (callback_connected_)
+    callback_connected_(new_client);
+
+  return new_client;
+}
+
+bool stream_listener::receive_client(Session& session, const argument& args)
+{
+  const auto client_socket = session.client->client_socket.id();
+
+  auto& buffer = session.buffer;
+
+  while (true)
+  {
+    ssize_t recv_size = ::recv(client_socket, buffer.data(), buffer.size(), args.client_recv_flags | MSG_DONTWAIT);
+
+    if (recv_size == 0)
+      return false;  // client disconnected
+
+    if (recv_size < 0)
+    {
+      if (errno == EINTR)
         continue;
-      }
-      else if (recv_size < 0)
-      {
-        error_ = "recv error : " + std::string(::strerror(errno));
-      }
-      else
-      {
-        // callback
-        if (args.using_rs_packet == false)
-        {
-          if (callback_received_)
-            callback_received_(&(iter->second), buffer.get(), recv_size);
-        }
-        else
-        {
-          auto& receiver = rs_packet_receiver_.find(&(iter->second))->second;
 
-          // regist callback for grab packet when received completed
-          receiver->attachCallback([&](const uint8_t* data, const ssize_t size) {
-            if (callback_received_)
-              callback_received_(&(iter->second), data, size);
-          });
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+        return true;
 
-          // store received data to temporary buffer
-          receiver->store(buffer.get(), recv_size);
+      if (is_connection_error(errno))
+        return false;  // client disconnected
 
-          // after store, progress received data and relese callback
-          receiver->resetCallback();
-        }
-      }
+      set_error("recv error : " + std::string(::strerror(errno)));
+      return true;
+    }
 
-      ++iter;
+    // 짧게 읽혀도 EAGAIN까지 계속 읽는다 (같은 edge에 도착한 FIN은 새 event로 통지되지 않는다)
+    deliver(session, buffer.data(), recv_size, args);
+  }
+}
+
+void stream_listener::deliver(Session& session, const uint8_t* data, ssize_t size, const argument& args)
+{
+  if (args.using_rs_packet && args.trace_rs_packet)
+    trace_packet(data, size);
+
+  // callback
+  if (args.using_rs_packet == false)
+  {
+    if (callback_received_)
+      callback_received_(session.client, data, size);
+  }
+  else
+  {
+    session.receiver->store_and_drain(data, size, session.packets);
+
+    if (callback_received_)
+      for (const auto& packet : session.packets)
+        callback_received_(session.client, packet.data, packet.size);
+  }
+}
+
+void stream_listener::remove_client(Reactor& reactor, int client_socket, const argument& args)
+{
+  auto iter = reactor.sessions.find(client_socket);
+  if (iter == reactor.sessions.end())
+    return;
+
+  auto client = iter->second.client;
+
+  // client disconnected
+  if (callback_disconnected_)
+    callback_disconnected_(client);
+
+  if (args.listener_backend == backend::epoll)
+    ::epoll_ctl(reactor.epoll_handle, EPOLL_CTL_DEL, client_socket, nullptr);
+
+  // remove client & session (send()와 socket close가 겹치지 않도록 reactor lock을 먼저 잡는다)
+  {
+    std::lock_guard<std::mutex> locker(reactor.mutex);
+
+    // io_uring : 등록된 POLLOUT 취소 (remove_client()는 reactor thread에서만 호출된다)
+    if (args.listener_backend == backend::io_uring && iter->second.writable_wait)
+      reactor.uring->prepareCancelRequest((static_cast<uint64_t>(client_socket) << 2) | URING_WRITABLE, URING_IGNORE);
+
+    {
+      std::lock_guard<std::mutex> clients_locker(connected_clients_mutex_);
+
+      auto connected = connected_clients_.find(client_socket);
+      if (connected != connected_clients_.end())
+      {
+        connected->second.client_socket.close();
+        connected_clients_.erase(connected);
+      }
     }
+
+    reactor.sessions.erase(iter);
   }
 }
 
+stream_listener::Reactor* stream_listener::reactor_of(const Client* client) const
+{
+  if (client == nullptr || client->reactor < 0 || client->reactor >= static_cast<int>(reactors_.size()))
+    return nullptr;
+
+  return reactors_[client->reactor].get();
+}
+
+void stream_listener::trace_packet(const uint8_t* data, ssize_t size)
+{
+  std::ostringstream oss;
+
+  oss << "\033[2;36m"
+      << "[TRACE RS PACKET] received size : " << size << std::endl;
+
+  for (int i = 0; i < size; ++i)
+    oss << std::hex << std::uppercase << std::setw(2) << std::setfill('0') << (unsigned int)data[i] << " ";
+  oss << std::endl;
+
+  oss << "[TRACE RS PACKET] end of packet"
+      << "\033[0m" << std::endl;
+
+  printf("%s", oss.str().c_str());
+}
+
 ssize_t stream_listener::send(const Client* client, const uint8_t* data, int size, int send_flag)
 {
   if (client == nullptr)
   {
-    error_ = "invalid client";
+    set_error("invalid client");
+    return false;
+  }
+
+  auto reactor = reactor_of(client);
+  if (reactor == nullptr)
+  {
+    set_error("invalid client reactor");
     return false;
   }
 
+  // output queue (event loop가 전송)
+  if (arguments_.client_send_queue && active_backend_ != backend::select)
+  {
+    struct iovec iov = { const_cast<uint8_t*>(data), static_cast<size_t>(std::max(size, 0)) };
+    return send_queued(*reactor, client, &iov, 1, send_flag);
+  }
+
   ssize_t res = 0;
 
   {
-    std::lock_guard<std::mutex> locker(connected_clients_mutex_);
+    std::lock_guard<std::mutex> locker(reactor->mutex);
     res = client->client_socket.send(data, size, send_flag);
   }
 
   // error handle
   if (res <= 0)
-    error_ = client->client_socket.error();
+    set_error(client->client_socket.error());
 
 #if 0  // recv에서 처리
   if (res == 0)  // client disconnected
@@ -292,6 +819,407 @@ ssize_t stream_listener::send(const Client* client, const rs::Packet& packet, in
   return send(client, packet.data(), packet.size(), send_flag);
 }
 
+ssize_t stream_listener::send(const Client* client, const rs::PacketGather& packet, int send_flag)
+{
+  if (client == nullptr)
+  {
+    set_error("invalid client");
+    return false;
+  }
+
+  auto reactor = reactor_of(client);
+  if (reactor == nullptr)
+  {
+    set_error("invalid client reactor");
+    return false;
+  }
+
+  packet.updateTimestamp();
+
+  // output queue (event loop가 전송)
+  if (arguments_.client_send_queue && active_backend_ != backend::select)
+  {
+    struct iovec iov[3];
+    int          iov_count = 0;
+
+    for (const auto& segment : packet.segments())
+      iov[iov_count++] = { const_cast<uint8_t*>(segment.data), segment.size };
+
+    return send_queued(*reactor, client, iov, iov_count, send_flag);
+  }
+
+  ssize_t res = 0;
+
+  {
+    std::lock_guard<std::mutex> locker(reactor->mutex);
+    res = client->client_socket.send(packet, send_flag);
+  }
+
+  if (res <= 0)
+    set_error(client->client_socket.error());
+
+  return res;
+}
+
+size_t stream_listener::broadcast(const uint8_t* data, int size, int send_flag)
+{
+  if (data == nullptr || size <= 0)
+  {
+    set_error("invalid data size");
+    return 0;
+  }
+
+  size_t count = 0;
+
+  // client마다 직접 전송
+  if (arguments_.client_send_queue == false || active_backend_ == backend::select)
+  {
+    for (auto& reactor : reactors_)
+    {
+      std::lock_guard<std::mutex> locker(reactor->mutex);
+
+      for (auto& [client_socket, session] : reactor->sessions)
+      {
+        if (session.client->client_socket.send(data, size, send_flag) > 0)
+          count++;
+        else
+          set_error(session.client->client_socket.error());
+      }
+    }
+
+    return count;
+  }
+
+  // output queue : 한 번만 복사한 버퍼를 모든 client가 공유한다
+  const int flags = (send_flag < 0 ? arguments_.client_send_flags : send_flag) | MSG_DONTWAIT;
+
+  OutputBuffer              buffer = std::make_shared<const std::vector<uint8_t>>(data, data + size);
+  std::vector<Backpressure> notifications;
+
+  for (auto& reactor : reactors_)
+  {
+    std::lock_guard<std::mutex> locker(reactor->mutex);
+
+    for (auto& [client_socket, session] : reactor->sessions)
+      if (broadcast_queued(*reactor, session, buffer, flags, notifications) > 0)
+        count++;
+  }
+
+  // callback 안에서 send()를 호출할 수 있도록 reactor lock 밖에서 호출한다
+  for (const auto& notification : notifications)
+    notify_backpressure(notification.client, notification.congested, notification.queued_size);
+
+  return count;
+}
+
+size_t stream_listener::broadcast(const rs::Packet& packet, int send_flag)
+{
+  packet.updateTimestamp();
+
+  return broadcast(packet.data(), packet.size(), send_flag);
+}
+
+ssize_t stream_listener::send_queued(Reactor& reactor, const Client* client, const struct iovec* iov, int iov_count, int send_flag)
+{
+  const int client_socket = client->client_socket.id();
+  const int flags         = (send_flag < 0 ? arguments_.client_send_flags : send_flag) | MSG_DONTWAIT;
+
+  size_t size = 0;
+  for (int i = 0; i < iov_count; ++i)
+    size += iov[i].iov_len;
+
+  if (size == 0)
+  {
+    set_error("invalid data size");
+    return -1;
+  }
+
+  bool   changed     = false;
+  bool   congested   = false;
+  size_t queued_size = 0;
+
+  {
+    std::lock_guard<std::mutex> locker(reactor.mutex);
+
+    auto iter = reactor.sessions.find(client_socket);
+    if (iter == reactor.sessions.end())
+    {
+      set_error("disconnected client");
+      return 0;
+    }
+
+    auto& session = iter->second;
+
+    // queue가 비어있으면 바로 한 번 전송한다 (queue가 남아있으면 순서 유지를 위해 뒤에 붙인다)
+    size_t sent_size = 0;
+
+    if (session.output.empty())
+    {
+      struct msghdr message = {};
+      message.msg_iov       = const_cast<struct iovec*>(iov);
+      message.msg_iovlen    = iov_count;
+
+      ssize_t res = ::sendmsg(client_socket, &message, flags);
+      if (res >= 0)
+        sent_size = res;
+      else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+      {
+        set_error(::strerror(errno));
+        return is_connection_error(errno) ? 0 : -1;
+      }
+    }
+
+    if (sent_size == size)
+      return size;
+
+    // queue 크기 제한 (일부라도 전송된 데이터는 stream이 깨지지 않도록 반드시 queue에 넣는다)
+    if (sent_size == 0 && limit_output(session, size) == false)
+    {
+      dropped_++;
+
+      if (arguments_.client_send_queue_policy == queue_policy::disconnect)
+      {
+        set_error("client output queue is full (disconnected)");
+        return 0;
+      }
+
+      set_error("client output queue is full");
+      return -1;
+    }
+
+    // 전송하지 못한 데이터는 queue에 복사하고 writable event를 기다린다
+    auto buffer = std::make_shared<std::vector<uint8_t>>();
+    buffer->reserve(size - sent_size);
+
+    for (int i = 0; i < iov_count; ++i)
+    {
+      auto data   = static_cast<const uint8_t*>(iov[i].iov_base);
+      auto length = iov[i].iov_len;
+
+      if (sent_size >= length)
+      {
+        sent_size -= length;
+        continue;
+      }
+
+      buffer->insert(buffer->end(), data + sent_size, data + length);
+      sent_size = 0;
+    }
+
+    session.output_size += buffer->size();
+    session.output.push_back({ std::move(buffer), 0 });
+
+    watch_writable(reactor, session, true);
+
+    changed     = update_congestion(session);
+    congested   = session.congested;
+    queued_size = session.output_size;
+  }
+
+  // callback 안에서 send()를 호출할 수 있도록 reactor lock 밖에서 호출한다
+  if (changed)
+    notify_backpressure(client, congested, queued_size);
+
+  return size;
+}
+
+ssize_t stream_listener::broadcast_queued(Reactor& reactor, Session& session, const OutputBuffer& buffer, int flags, std::vector<Backpressure>& notifications)
+{
+  const int    client_socket = session.client->client_socket.id();
+  const size_t size          = buffer->size();
+
+  // queue가 비어있으면 바로 한 번 전송한다
+  size_t sent_size = 0;
+
+  if (session.output.empty())
+  {
+    ssize_t res = ::send(client_socket, buffer->data(), size, flags);
+    if (res >= 0)
+      sent_size = res;
+    else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+    {
+      set_error(::strerror(errno));
+      return is_connection_error(errno) ? 0 : -1;
+    }
+  }
+
+  if (sent_size == size)
+    return size;
+
+  if (sent_size == 0 && limit_output(session, size) == false)
+  {
+    dropped_++;
+    set_error("client output queue is full");
+    return arguments_.client_send_queue_policy == queue_policy::disconnect ? 0 : -1;
+  }
+
+  // 버퍼는 복사하지 않고 참조만 queue에 넣는다
+  session.output_size += size - sent_size;
+  session.output.push_back({ buffer, sent_size });
+
+  watch_writable(reactor, session, true);
+
+  if (update_congestion(session))
+    notifications.push_back({ session.client, session.congested, session.output_size });
+
+  return size;
+}
+
+void stream_listener::watch_writable(Reactor& reactor, Session& session, bool enable)
+{
+  if (session.writable_wait == enable)
+    return;
+
+  session.writable_wait = enable;
+
+  const int client_socket = session.client->client_socket.id();
+
+  // epoll : EPOLLOUT 추가, 제거
+  if (active_backend_ == backend::epoll)
+  {
+    struct epoll_event event = {};
+    event.events             = EPOLLIN | EPOLLRDHUP | EPOLLET | (enable ? EPOLLOUT : 0);
+    event.data.ptr           = &session;
+
+    if (::epoll_ctl(reactor.epoll_handle, EPOLL_CTL_MOD, client_socket, &event) == -1)
+      set_error("epoll_ctl error : " + std::string(::strerror(errno)));
+  }
+
+  // io_uring : reactor thread가 POLLOUT을 등록한다 (oneshot이므로 해제는 필요 없다)
+  if (active_backend_ == backend::io_uring && enable)
+  {
+    reactor.writable_requests.push_back(client_socket);
+
+    uint64_t count = 1;
+    if (::write(reactor.event_handle, &count, sizeof(count)) < 0)
+      set_error("eventfd write error : " + std::string(::strerror(errno)));
+  }
+}
+
+bool stream_listener::flush_client(Reactor& reactor, Session& session)
+{
+  auto& output = session.output;
+
+  // writable event 한 번에 queue의 앞쪽 메시지들을 sendmsg() 한 번으로 전송한다
+  if (output.empty() == false)
+  {
+    const int client_socket = session.client->client_socket.id();
+
+    struct iovec iov[MAX_FLUSH_IOV];
+    int          iov_count = 0;
+
+    for (auto iter = output.begin(); iter != output.end() && iov_count < MAX_FLUSH_IOV; ++iter)
+      iov[iov_count++] = { const_cast<uint8_t*>(iter->buffer->data()) + iter->offset, iter->buffer->size() - iter->offset };
+
+    struct msghdr message = {};
+    message.msg_iov       = iov;
+    message.msg_iovlen    = iov_count;
+
+    ssize_t res = ::sendmsg(client_socket, &message, arguments_.client_send_flags | MSG_DONTWAIT);
+    if (res < 0)
+    {
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+        return false;
+
+      // 전송 불가 : queue를 버리고 연결을 끊는다 (수신 측에서 client가 제거된다)
+      set_error("send error : " + std::string(::strerror(errno)));
+      output.clear();
+      session.output_size = 0;
+      ::shutdown(client_socket, SHUT_RDWR);
+    }
+    else
+    {
+      // 전송 완료된 메시지 제거
+      size_t sent_size = res;
+      session.output_size -= sent_size;
+
+      while (sent_size > 0)
+      {
+        auto&  front  = output.front();
+        size_t remain = front.buffer->size() - front.offset;
+
+        if (sent_size < remain)
+        {
+          front.offset += sent_size;
+          break;
+        }
+
+        sent_size -= remain;
+        output.pop_front();
+      }
+    }
+  }
+
+  if (output.empty())
+    watch_writable(reactor, session, false);
+
+  return update_congestion(session);
+}
+
+bool stream_listener::limit_output(Session& session, size_t size)
+{
+  const size_t max_size = arguments_.client_send_queue_max;
+
+  if (max_size == 0 || session.output_size + size <= max_size)
+    return true;
+
+  switch (arguments_.client_send_queue_policy)
+  {
+    case queue_policy::drop_oldest:
+    {
+      // 전송을 시작한 맨 앞 메시지는 남겨둔다 (stream 중간이 잘리지 않도록)
+      auto& output = session.output;
+      auto  first  = (output.empty() == false && output.front().offset > 0) ? 1 : 0;
+
+      while (output.size() > static_cast<size_t>(first) && session.output_size + size > max_size)
+      {
+        auto iter = output.begin() + first;
+
+        session.output_size -= iter->buffer->size() - iter->offset;
+        output.erase(iter);
+        dropped_++;
+      }
+      return true;
+    }
+
+    case queue_policy::disconnect:
+    {
+      // 수신 측에서 client가 제거된다
+      session.output.clear();
+      session.output_size = 0;
+      ::shutdown(session.client->client_socket.id(), SHUT_RDWR);
+      return false;
+    }
+
+    default:
+      return false;
+  }
+}
+
+bool stream_listener::update_congestion(Session& session) const
+{
+  // high watermark 초과 : congested, low watermark 이하 : relieved
+  if (session.congested == false && session.output_size > arguments_.client_send_queue_high)
+  {
+    session.congested = true;
+    return true;
+  }
+
+  if (session.congested && session.output_size <= std::min(arguments_.client_send_queue_low, arguments_.client_send_queue_high))
+  {
+    session.congested = false;
+    return true;
+  }
+
+  return false;
+}
+
+void stream_listener::notify_backpressure(const Client* client, bool congested, size_t queued_size)
+{
+  if (callback_backpressure_)
+    callback_backpressure_(client, congested, queued_size);
+}
+
 const std::unordered_map<int, stream_listener::Client>& stream_listener::clients() const
 {
   std::lock_guard<std::mutex> locker(connected_clients_mutex_);
@@ -339,5 +1267,12 @@ void stream_listener::attachReceivedCallback(const OnReceivedCallback& callback)
   callback_received_ = callback;
 }
 
+void stream_listener::attachBackpressureCallback(const OnBackpressureCallback& callback)
+{
+  std::lock_guard<std::mutex> locker(listener_lock_);
+
+  callback_backpressure_ = callback;
+}
+
 }  // namespace network
 }  // namespace rs
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <rowen/core/transport/packet_builder.hpp>
+#include <rowen/network/listener_stream.hpp>
+#include <thread>
+
+#include "../example-packet/allocation-counter.hpp"
+#include "benchmark-common.hpp"
+
+// 수신 경로의 heap 할당 횟수 (연결, 세션 생성 이후의 steady state)
+// - client (child process)가 rs packet을 연속으로 보내고, listener callback에서 warm up 이후의 할당 횟수를 센다
+// - 부모 프로세스의 main thread는 waitpid()로 대기하므로 할당은 listener thread에서만 발생한다
+inline void measure_allocation(rs::network::stream_listener::backend backend, const char* name, int port, bool using_rs_packet)
+{
+  constexpr size_t WARMUP_COUNT  = 1000;
+  constexpr size_t MESSAGE_COUNT = 100000;
+  constexpr size_t PAYLOAD_SIZE  = 64;
+
+  std::atomic<size_t> received_size    = { 0 };
+  std::atomic<size_t> allocation_begin = { 0 };
+  std::atomic<size_t> allocation_end   = { 0 };
+
+  const size_t packet_size = rs::Packet::PACKET_SIZE(PAYLOAD_SIZE);
+
+  rs::network::stream_listener listener;
+
+  listener.attachReceivedCallback([&](const rs::network::stream_listener::Client*, const uint8_t*, int size) {
+    // 수신 크기로 packet 수를 센다 (rs packet이 아니면 packet 경계와 관계없이 전달된다)
+    size_t count = (received_size.fetch_add(size) + size) / packet_size;
+
+    if (count >= WARMUP_COUNT && allocation_begin.load() == 0)
+      allocation_begin = allocation_count.load();
+
+    if (count >= WARMUP_COUNT + MESSAGE_COUNT && allocation_end.load() == 0)
+      allocation_end = allocation_count.load();
+  });
+
+  rs::network::stream_listener::argument args;
+  args.listener_backend        = backend;
+  args.listener_select_timeout = 0.1;
+  args.using_rs_packet         = using_rs_packet;
+
+  if (listener.running(port, args) == false)
+  {
+    printf("  %-8s : failed to run listener (%s)\n", name, listener.error());
+    return;
+  }
+
+  run_in_child([&] {
+    int handle = connect_loopback(port);
+    if (handle < 0)
+      return;
+
+    // 64 packets 단위로 전송한다
+    std::vector<uint8_t> batch(packet_size * 64);
+    uint8_t              payload[PAYLOAD_SIZE] = {};
+
+    for (size_t i = 0; i < 64; ++i)
+      rs::Packet::serialize(batch.data() + i * packet_size, packet_size, 0, 0, 0, 1, payload, sizeof(payload));
+
+    for (size_t sent = 0; sent < WARMUP_COUNT + MESSAGE_COUNT; sent += 64)
+      if (send_all(handle, batch.data(), batch.size()) == false)
+        break;
+
+    ::close(handle);
+  });
+
+  for (int i = 0; i < 200 && allocation_end.load() == 0; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  if (allocation_end.load() == 0)
+    printf("  %-8s rs_packet %-3s : not completed (received %zu)\n", name, using_rs_packet ? "on" : "off", received_size.load() / packet_size);
+  else
+    printf("  %-8s rs_packet %-3s : %6zu allocations / %zu packets\n",
+           name, using_rs_packet ? "on" : "off", allocation_end.load() - allocation_begin.load(), MESSAGE_COUNT);
+
+  listener.stop();
+}
+
+inline int run_benchmark_allocation()
+{
+  using backend = rs::network::stream_listener::backend;
+
+  int port = 19700;
+
+  printf("[ALLOCATION] stream_listener receive path (steady state)\n");
+
+  for (bool using_rs_packet : { false, true })
+  {
+    measure_allocation(backend::select, "select", port++, using_rs_packet);
+    measure_allocation(backend::epoll, "epoll", port++, using_rs_packet);
+    measure_allocation(backend::io_uring, "io_uring", port++, using_rs_packet);
+  }
+
+  return 0;
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <rowen/network/listener_stream.hpp>
+#include <thread>
+
+#include "benchmark-common.hpp"
+
+// listener -> viewer fan-out (1 slow viewer : 수신하지 않음, 나머지 : 계속 수신)
+// - blocking : send()가 slow viewer의 send timeout 동안 block 되어 다른 viewer 전송이 같이 지연된다
+// - queue : client output queue (client_send_queue_max, client_send_queue_policy)로 slow viewer의 데이터만 쌓이거나 버려진다
+inline void measure_fanout(const char* name, int port, bool send_queue, rs::network::stream_listener::queue_policy policy)
+{
+  using listener_type = rs::network::stream_listener;
+
+  constexpr size_t FAST_VIEWERS = 4;
+  constexpr size_t FRAME_COUNT  = 100;
+  constexpr size_t FRAME_SIZE   = 64 * 1024;
+
+  listener_type listener;
+
+  std::mutex                                clients_mutex;
+  std::vector<const listener_type::Client*> clients;  // 접속 순서 (0 : slow viewer)
+
+  std::atomic<size_t> congested_count = { 0 };
+
+  listener.attachConnectedCallback([&](const listener_type::Client* client) {
+    std::lock_guard<std::mutex> locker(clients_mutex);
+    clients.push_back(client);
+  });
+
+  listener.attachBackpressureCallback([&](const listener_type::Client*, bool congested, size_t) {
+    if (congested)
+      congested_count++;
+  });
+
+  listener_type::argument args;
+  args.listener_backend         = listener_type::backend::epoll;
+  args.listener_select_timeout  = 0.1;
+  args.client_send_timeout      = 0.05;
+  args.client_send_queue        = send_queue;
+  args.client_send_queue_high   = 1 << 20;
+  args.client_send_queue_low    = 256 << 10;
+  args.client_send_queue_max    = 2 << 20;
+  args.client_send_queue_policy = policy;
+
+  if (listener.running(port, args) == false)
+  {
+    printf("  %-22s : failed to run listener (%s)\n", name, listener.error());
+    return;
+  }
+
+  // slow viewer를 먼저 연결한다
+  std::vector<int> viewers;
+
+  for (size_t i = 0; i < FAST_VIEWERS + 1; ++i)
+  {
+    viewers.push_back(connect_loopback(port));
+
+    for (int wait = 0; wait < 100; ++wait)
+    {
+      {
+        std::lock_guard<std::mutex> locker(clients_mutex);
+        if (clients.size() > i)
+          break;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  if (clients.size() != viewers.size())
+  {
+    printf("  %-22s : failed to connect viewers\n", name);
+    for (auto viewer : viewers)
+      ::close(viewer);
+    listener.stop();
+    return;
+  }
+
+  // fast viewers
+  std::atomic_bool    receiving     = { true };
+  std::atomic<size_t> received_size = { 0 };
+
+  std::thread receiver([&]() {
+    std::vector<uint8_t> buffer(256 * 1024);
+
+    while (receiving)
+    {
+      bool idle = true;
+
+      for (size_t i = 1; i < viewers.size(); ++i)
+      {
+        ssize_t size = ::recv(viewers[i], buffer.data(), buffer.size(), MSG_DONTWAIT);
+        if (size > 0)
+        {
+          received_size += size;
+          idle = false;
+        }
+      }
+
+      if (idle)
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  });
+
+  std::vector<uint8_t> frame(FRAME_SIZE, 0x5A);
+  std::vector<double>  latency;
+  latency.reserve(FRAME_COUNT);
+
+  for (size_t i = 0; i < FRAME_COUNT; ++i)
+  {
+    auto begin = bench_clock::now();
+
+    for (auto client : clients)
+      listener.send(client, frame.data(), static_cast<int>(frame.size()));
+
+    latency.push_back(std::chrono::duration<double, std::micro>(bench_clock::now() - begin).count());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  const size_t expected_size = FAST_VIEWERS * FRAME_COUNT * FRAME_SIZE;
+  for (int i = 0; i < 200 && received_size.load() < expected_size; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  receiving = false;
+  receiver.join();
+
+  printf("  %-22s : fan-out p50 %8.1f us, p99 %8.1f us, fast viewers %5.1f %%, congested %zu, dropped %llu\n",
+         name, percentile(latency, 0.50), percentile(latency, 0.99), 100.0 * received_size.load() / expected_size,
+         congested_count.load(), static_cast<unsigned long long>(listener.dropped()));
+
+  for (auto viewer : viewers)
+    ::close(viewer);
+
+  listener.stop();
+}
+
+inline int run_benchmark_backpressure()
+{
+  using policy = rs::network::stream_listener::queue_policy;
+
+  int port = 19800;
+
+  printf("[BACKPRESSURE] fan-out 64 KiB frames to 1 slow + 4 fast viewers (queue high 1 MiB, low 256 KiB, max 2 MiB)\n");
+
+  measure_fanout("blocking send", port++, false, policy::drop_newest);
+  measure_fanout("queue drop_newest", port++, true, policy::drop_newest);
+  measure_fanout("queue drop_oldest", port++, true, policy::drop_oldest);
+  measure_fanout("queue disconnect", port++, true, policy::disconnect);
+
+  return 0;
+}
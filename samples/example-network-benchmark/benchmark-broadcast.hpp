@@ -0,0 +1,136 @@
+#pragma once
+
+#include <poll.h>
+
+#include <atomic>
+#include <mutex>
+#include <rowen/network/listener_stream.hpp>
+#include <thread>
+
+#include "benchmark-common.hpp"
+
+// listener -> 모든 client 전송 (client_send_queue)
+// - send loop : client마다 send() (client마다 전송하지 못한 데이터를 복사)
+// - broadcast : 한 번 복사한 refcount 버퍼를 모든 client output queue가 공유
+// - viewer는 전송이 끝난 후 수신을 시작한다 (socket 버퍼를 넘는 데이터는 output queue에 쌓인다)
+// - latency : 전송 호출 시간 (모든 client), throughput : 모든 client가 수신할 때까지의 처리량
+inline void measure_broadcast(const char* name, int port, bool broadcast, size_t client_count, size_t payload_size)
+{
+  using listener_type = rs::network::stream_listener;
+
+  constexpr size_t MESSAGE_COUNT = 200;
+
+  listener_type listener;
+
+  std::mutex                                clients_mutex;
+  std::vector<const listener_type::Client*> clients;
+
+  listener.attachConnectedCallback([&](const listener_type::Client* client) {
+    std::lock_guard<std::mutex> locker(clients_mutex);
+    clients.push_back(client);
+  });
+
+  listener_type::argument args;
+  args.listener_backend        = listener_type::backend::epoll;
+  args.listener_select_timeout = 0.1;
+  args.listener_max_events     = 1024;
+  args.backlog                 = 1024;
+  args.client_send_queue       = true;
+  args.client_send_queue_max   = 0;
+
+  if (listener.running(port, args) == false)
+  {
+    printf("  %-10s : failed to run listener (%s)\n", name, listener.error());
+    return;
+  }
+
+  std::vector<struct pollfd> viewers;
+
+  for (size_t i = 0; i < client_count; ++i)
+    viewers.push_back({ connect_loopback(port), POLLIN, 0 });
+
+  for (int wait = 0; wait < 1000 && clients.size() < client_count; ++wait)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  std::vector<uint8_t> payload(payload_size, 0x5A);
+  rs::Packet           packet;
+  packet.make(1, payload.data(), payload.size());
+
+  std::vector<double> latency;
+  latency.reserve(MESSAGE_COUNT);
+
+  std::lock_guard<std::mutex> locker(clients_mutex);
+
+  auto begin = bench_clock::now();
+
+  for (size_t i = 0; i < MESSAGE_COUNT; ++i)
+  {
+    auto send_begin = bench_clock::now();
+
+    if (broadcast)
+      listener.broadcast(packet);
+    else
+      for (auto client : clients)
+        listener.send(client, packet);
+
+    latency.push_back(std::chrono::duration<double, std::micro>(bench_clock::now() - send_begin).count());
+  }
+
+  std::atomic_bool    receiving     = { true };
+  std::atomic<size_t> received_size = { 0 };
+
+  std::thread receiver([&]() {
+    std::vector<uint8_t> buffer(256 * 1024);
+
+    while (receiving)
+    {
+      if (::poll(viewers.data(), viewers.size(), 10) <= 0)
+        continue;
+
+      for (auto& viewer : viewers)
+      {
+        if ((viewer.revents & POLLIN) == 0)
+          continue;
+
+        ssize_t size = ::recv(viewer.fd, buffer.data(), buffer.size(), MSG_DONTWAIT);
+        if (size > 0)
+          received_size += size;
+      }
+    }
+  });
+
+  const size_t expected_size = clients.size() * MESSAGE_COUNT * packet.size();
+  for (int i = 0; i < 1000 && received_size.load() < expected_size; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  double elapsed = std::chrono::duration<double>(bench_clock::now() - begin).count();
+
+  receiving = false;
+  receiver.join();
+
+  printf("  %-10s clients %4zu, payload %6zu : call p50 %8.1f us, p99 %8.1f us, %8.1f MiB/s (received %5.1f %%)\n",
+         name, clients.size(), payload_size, percentile(latency, 0.50), percentile(latency, 0.99),
+         received_size.load() / elapsed / (1024 * 1024), 100.0 * received_size.load() / expected_size);
+
+  for (auto& viewer : viewers)
+    ::close(viewer.fd);
+
+  listener.stop();
+}
+
+inline int run_benchmark_broadcast()
+{
+  raise_file_limit();
+
+  int port = 19850;
+
+  printf("[BROADCAST] send loop vs broadcast (epoll, client_send_queue)\n");
+
+  for (size_t client_count : { 16, 64 })
+  {
+    measure_broadcast("send loop", port++, false, client_count, 16384);
+    measure_broadcast("broadcast", port++, true, client_count, 16384);
+  }
+
+  return 0;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <netinet/tcp.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <rowen/network/detail/socket.hpp>
+#include <vector>
+
+using bench_clock = std::chrono::steady_clock;
+
+// 열 수 있는 file descriptor 수를 최대로 늘린다
+inline void raise_file_limit()
+{
+  struct rlimit limit;
+  if (getrlimit(RLIMIT_NOFILE, &limit) == 0)
+  {
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+  }
+}
+
+// loopback TCP 연결 (blocking)
+inline int connect_loopback(int port, bool no_delay = true)
+{
+  int handle = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (handle < 0)
+    return -1;
+
+  sockaddr_in address     = {};
+  address.sin_family      = AF_INET;
+  address.sin_port        = htons(port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  if (::connect(handle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+  {
+    ::close(handle);
+    return -1;
+  }
+
+  int flag = no_delay ? 1 : 0;
+  ::setsockopt(handle, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+  return handle;
+}
+
+inline bool send_all(int handle, const uint8_t* data, size_t size)
+{
+  while (size > 0)
+  {
+    ssize_t sent = ::send(handle, data, size, MSG_NOSIGNAL);
+    if (sent <= 0)
+      return false;
+    data += sent;
+    size -= sent;
+  }
+  return true;
+}
+
+inline bool recv_all(int handle, uint8_t* data, size_t size)
+{
+  return ::recv(handle, data, size, MSG_WAITALL) == static_cast<ssize_t>(size);
+}
+
+inline double percentile(std::vector<double>& samples, double ratio)
+{
+  if (samples.empty())
+    return 0;
+
+  std::sort(samples.begin(), samples.end());
+  return samples[std::min(samples.size() - 1, static_cast<size_t>(samples.size() * ratio))];
+}
+
+// client를 별도 프로세스에서 실행한다 (file descriptor 제한을 서버와 나누지 않는다)
+inline void run_in_child(const std::function<void()>& function)
+{
+  fflush(stdout);
+
+  pid_t pid = fork();
+  if (pid == 0)
+  {
+    raise_file_limit();
+    function();
+    fflush(stdout);
+    _exit(0);
+  }
+
+  if (pid > 0)
+    waitpid(pid, nullptr, 0);
+}
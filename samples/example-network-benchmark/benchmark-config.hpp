@@ -0,0 +1,66 @@
+#pragma once
+
+#include <ifaddrs.h>
+
+#include <fstream>
+#include <rowen/network/config.hpp>
+#include <string>
+
+#include "benchmark-common.hpp"
+
+// health check 한 번 (IPAddress, SubnetMask, Gateway, MacAddress)
+// - proc : 조회마다 getifaddrs / /proc/net/route를 읽는다 (이전 config 조회 방식)
+// - snapshot : rs::network::config (netlink로 갱신되는 snapshot)
+inline size_t health_check_proc()
+{
+  size_t size = 0;
+
+  struct ifaddrs* ifaddr = nullptr;
+  if (getifaddrs(&ifaddr) == 0)
+  {
+    for (struct ifaddrs* ifa = ifaddr; ifa != nullptr; ifa = ifa->ifa_next)
+      size++;
+    freeifaddrs(ifaddr);
+  }
+
+  std::ifstream route_file("/proc/net/route");
+  std::string   line;
+  while (std::getline(route_file, line))
+    size += line.size();
+
+  return size;
+}
+
+inline size_t health_check_snapshot()
+{
+  return rs::network::config::IPAddress().size() + rs::network::config::SubnetMask().size() +
+         rs::network::config::Gateway().size() + rs::network::config::MacAddress().size();
+}
+
+template <typename Check>
+inline void measure_health_check(const char* name, Check check)
+{
+  constexpr size_t CHECK_COUNT = 20000;
+
+  size_t size  = 0;
+  auto   begin = bench_clock::now();
+
+  for (size_t i = 0; i < CHECK_COUNT; ++i)
+    size += check();
+
+  double elapsed = std::chrono::duration<double, std::micro>(bench_clock::now() - begin).count();
+
+  printf("  %-9s : %8.3f us / check (%zu)\n", name, elapsed / CHECK_COUNT, size);
+}
+
+inline int run_benchmark_config()
+{
+  printf("[CONFIG] interface query per health check (auto : %s, ip %s, gateway %s)\n",
+         rs::network::config::InterfaceList().empty() ? "-" : rs::network::config::InterfaceList().front().c_str(),
+         rs::network::config::IPAddress().c_str(), rs::network::config::Gateway().c_str());
+
+  measure_health_check("proc", health_check_proc);
+  measure_health_check("snapshot", health_check_snapshot);
+
+  return 0;
+}
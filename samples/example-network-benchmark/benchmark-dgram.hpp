@@ -0,0 +1,215 @@
+#pragma once
+
+#include <atomic>
+#include <rowen/network/connector_dgram.hpp>
+#include <rowen/network/listener_dgram.hpp>
+#include <thread>
+
+#include "benchmark-common.hpp"
+
+// connector -> listener 단방향 datagram 전송 (loopback)
+// - receive : datagram마다 recv() vs recvmmsg batch
+// - send : datagram마다 sendto() vs sendmmsg batch (sendto_batch)
+// - UDP이므로 수신측이 느리면 손실이 발생한다 (received / sent를 함께 출력한다)
+inline void measure_dgram(const char* name, int port, int recv_batch_size, bool send_batch)
+{
+  constexpr size_t MESSAGE_COUNT = 200000;
+  constexpr size_t PAYLOAD_SIZE  = 64;
+  constexpr size_t BATCH_SIZE    = 64;
+
+  std::atomic<size_t> received_count = { 0 };
+
+  rs::network::dgram_listener listener;
+
+  listener.attachReceivedCallback([&](const uint8_t*, size_t, const sockaddr*, const socklen_t) {
+    received_count.fetch_add(1, std::memory_order_relaxed);
+  });
+
+  listener.attachReceivedBatchCallback([&](const rs::network::dgram_listener::Datagram*, size_t count) {
+    received_count.fetch_add(count, std::memory_order_relaxed);
+  });
+
+  rs::network::dgram_listener::argument listener_args;
+  listener_args.listener_select_timeout  = 0.1;
+  listener_args.listener_recv_max_size   = 2048;
+  listener_args.listener_recv_batch_size = recv_batch_size;
+
+  if (listener.running(port, listener_args) == false)
+  {
+    printf("  %-16s : failed to run listener (%s)\n", name, listener.error());
+    return;
+  }
+
+  rs::network::dgram_connector connector;
+  if (connector.initialize("127.0.0.1", port) == false)
+  {
+    printf("  %-16s : failed to initialize connector (%s)\n", name, connector.error());
+    listener.stop();
+    return;
+  }
+
+  std::vector<uint8_t>        payload(PAYLOAD_SIZE, 0x5A);
+  std::vector<rs::PacketSpan> datagrams(BATCH_SIZE, rs::PacketSpan{ payload.data(), payload.size() });
+
+  size_t sent_count = 0;
+
+  auto begin = bench_clock::now();
+
+  while (sent_count < MESSAGE_COUNT)
+  {
+    if (send_batch)
+    {
+      auto res = connector.sendto_batch(datagrams.data(), std::min(BATCH_SIZE, MESSAGE_COUNT - sent_count));
+      if (res <= 0)
+        break;
+      sent_count += res;
+    }
+    else
+    {
+      if (connector.sendto(payload.data(), payload.size()) <= 0)
+        break;
+      sent_count++;
+    }
+
+    // 수신측이 따라올 수 있도록 socket buffer가 넘치기 전에 양보한다
+    if (sent_count - received_count.load(std::memory_order_relaxed) > 128)
+      std::this_thread::yield();
+  }
+
+  double send_elapsed = std::chrono::duration<double>(bench_clock::now() - begin).count();
+
+  // 수신이 더 이상 늘어나지 않을 때까지 기다린다
+  size_t last_count = 0;
+  auto   last_time  = bench_clock::now();
+  while (received_count.load() < sent_count)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    size_t count = received_count.load();
+    if (count != last_count)
+    {
+      last_count = count;
+      last_time  = bench_clock::now();
+    }
+    else if (bench_clock::now() - last_time > std::chrono::milliseconds(200))
+      break;
+  }
+
+  double elapsed = std::chrono::duration<double>(last_time - begin).count();
+  if (received_count.load() >= sent_count)
+    elapsed = std::chrono::duration<double>(bench_clock::now() - begin).count();
+
+  printf("  %-16s : send %9.0f datagrams/s, receive %9.0f datagrams/s (received %zu / %zu)\n",
+         name, sent_count / send_elapsed, received_count.load() / elapsed, received_count.load(), sent_count);
+
+  listener.stop();
+}
+
+// connector -> listener 대용량 datagram stream (loopback)
+// - send : segment마다 sendto() vs UDP GSO (super buffer 하나당 sendmsg 한 번)
+// - receive : recvmmsg batch vs UDP GRO (합쳐진 segment를 한 번에 수신)
+// - syscall 수 : send는 sendto/sendmsg 호출 수, receive는 데이터를 반환한 recvmmsg 호출 수 (batch callback 호출 수)
+inline void measure_gso(const char* name, int port, bool gso, bool gro)
+{
+  constexpr size_t TOTAL_SIZE    = 256 * 1024 * 1024;
+  constexpr size_t SEGMENT_SIZE  = 1472;
+  constexpr size_t SUPER_SIZE    = (rs::network::MAX_UDP_PAYLOAD_SIZE / SEGMENT_SIZE) * SEGMENT_SIZE;
+  constexpr size_t INFLIGHT_SIZE = 64 * 1024;
+
+  std::atomic<size_t> received_size = { 0 };
+  std::atomic<size_t> recv_calls    = { 0 };
+  std::atomic<size_t> coalesced     = { 0 };
+
+  rs::network::dgram_listener listener;
+
+  listener.attachReceivedBatchCallback([&](const rs::network::dgram_listener::Datagram* datagrams, size_t count) {
+    size_t size = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      size += datagrams[i].size;
+      if (datagrams[i].segment_size > 0 && datagrams[i].size > datagrams[i].segment_size)
+        coalesced.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    recv_calls.fetch_add(1, std::memory_order_relaxed);
+    received_size.fetch_add(size, std::memory_order_relaxed);
+  });
+
+  rs::network::dgram_listener::argument listener_args;
+  listener_args.listener_select_timeout  = 0.1;
+  listener_args.listener_recv_max_size   = SEGMENT_SIZE;
+  listener_args.listener_recv_batch_size = 8;
+  listener_args.listener_recv_gro        = gro;
+
+  if (listener.running(port, listener_args) == false)
+  {
+    printf("  %-16s : failed to run listener (%s)\n", name, listener.error());
+    return;
+  }
+
+  rs::network::dgram_connector::argument connector_args;
+  connector_args.send_segment_size = gso ? SEGMENT_SIZE : 0;
+
+  rs::network::dgram_connector connector;
+  if (connector.initialize("127.0.0.1", port, connector_args) == false)
+  {
+    printf("  %-16s : failed to initialize connector (%s)\n", name, connector.error());
+    listener.stop();
+    return;
+  }
+
+  // GSO : super buffer 단위로 sendto()를 호출한다, 그 외 : segment 단위로 호출한다
+  const size_t         send_size = gso ? SUPER_SIZE : SEGMENT_SIZE;
+  std::vector<uint8_t> payload(send_size, 0x5A);
+
+  size_t sent_size  = 0;
+  size_t send_calls = 0;
+
+  auto begin = bench_clock::now();
+
+  while (sent_size < TOTAL_SIZE)
+  {
+    if (connector.sendto(payload.data(), payload.size()) <= 0)
+    {
+      printf("  %-16s : send failed (%s)\n", name, connector.error());
+      break;
+    }
+
+    sent_size += payload.size();
+    send_calls++;
+
+    while (sent_size - received_size.load(std::memory_order_relaxed) > INFLIGHT_SIZE)
+      std::this_thread::yield();
+  }
+
+  for (int i = 0; i < 100 && received_size.load() < sent_size; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+  double elapsed = std::chrono::duration<double>(bench_clock::now() - begin).count();
+
+  printf("  %-16s : %7.1f MiB/s, send syscalls %7zu, recv syscalls %7zu, coalesced %6zu (received %zu / %zu MiB)\n",
+         name, received_size.load() / elapsed / (1024 * 1024), send_calls, recv_calls.load(), coalesced.load(),
+         received_size.load() >> 20, sent_size >> 20);
+
+  listener.stop();
+}
+
+inline int run_benchmark_dgram()
+{
+  int port = 19500;
+
+  printf("[DGRAM] recv/sendto vs recvmmsg/sendmmsg (64 bytes datagram)\n");
+
+  measure_dgram("recv, sendto", port++, 0, false);
+  measure_dgram("batch, sendto", port++, 64, false);
+  measure_dgram("recv, batch", port++, 0, true);
+  measure_dgram("batch, batch", port++, 64, true);
+
+  printf("[DGRAM] UDP GSO / GRO (1472 bytes segment, 256 MiB)\n");
+
+  measure_gso("plain", port++, false, false);
+  measure_gso("gso", port++, true, false);
+  measure_gso("gso, gro", port++, true, true);
+
+  return 0;
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <rowen/network/listener_stream.hpp>
+#include <string>
+#include <thread>
+
+#include "benchmark-common.hpp"
+
+// echo server (listener backend) <-> client_count 개의 연결
+// - latency : 한 client의 왕복 시간 (나머지 client는 idle)
+// - burst : 모든 client가 동시에 전송했을 때의 처리량
+// - reactors : reactor thread 수 (epoll, SO_REUSEPORT. reactor i는 CPU i % nproc에 고정)
+inline void measure_listener(rs::network::stream_listener::backend backend, const char* name, int port, size_t client_count, int reactors = 1)
+{
+  constexpr size_t MESSAGE_SIZE = 32;
+  constexpr size_t LATENCY_LOOP = 2000;
+  constexpr size_t BURST_ROUND  = 5;
+
+  rs::network::stream_listener listener;
+
+  listener.attachReceivedCallback([&](const rs::network::stream_listener::Client* client, const uint8_t* data, int size) {
+    listener.send(client, data, size);
+  });
+
+  rs::network::stream_listener::argument args;
+  args.listener_backend        = backend;
+  args.backlog                 = 4096;
+  args.listener_select_timeout = 0.1;
+  args.listener_reactors       = reactors;
+
+  if (reactors > 1)
+    for (int i = 0; i < reactors; ++i)
+      args.listener_reactor_affinity.push_back(i % std::max(1u, std::thread::hardware_concurrency()));
+
+  if (listener.running(port, args) == false)
+  {
+    printf("  %-8s %6zu clients : failed to run listener (%s)\n", name, client_count, listener.error());
+    return;
+  }
+
+  // 서버(listener thread)의 CPU 사용 시간 (부모 프로세스의 main thread는 대기 중)
+  struct rusage usage_begin;
+  getrusage(RUSAGE_SELF, &usage_begin);
+
+  run_in_child([&] {
+    std::vector<int> clients;
+    clients.reserve(client_count);
+
+    for (size_t i = 0; i < client_count; ++i)
+    {
+      int handle = connect_loopback(port);
+      if (handle < 0)
+      {
+        printf("  %-8s %6zu clients : connect failed at %zu (%s)\n", name, client_count, i, strerror(errno));
+        break;
+      }
+      clients.push_back(handle);
+    }
+
+    if (clients.size() != client_count)
+      return;
+
+    uint8_t message[MESSAGE_SIZE] = {};
+    uint8_t echo[MESSAGE_SIZE];
+
+    // latency (1 active client)
+    std::vector<double> latency;
+    latency.reserve(LATENCY_LOOP);
+
+    for (size_t i = 0; i < LATENCY_LOOP; ++i)
+    {
+      int  handle = clients[i % std::min<size_t>(clients.size(), 16)];
+      auto begin  = bench_clock::now();
+
+      if (!send_all(handle, message, sizeof(message)) || !recv_all(handle, echo, sizeof(echo)))
+      {
+        printf("  %-8s %6zu clients : echo failed\n", name, client_count);
+        return;
+      }
+
+      latency.push_back(std::chrono::duration<double, std::micro>(bench_clock::now() - begin).count());
+    }
+
+    // burst (all clients)
+    auto begin = bench_clock::now();
+
+    for (size_t round = 0; round < BURST_ROUND; ++round)
+    {
+      for (int handle : clients)
+        send_all(handle, message, sizeof(message));
+      for (int handle : clients)
+        recv_all(handle, echo, sizeof(echo));
+    }
+
+    double elapsed = std::chrono::duration<double>(bench_clock::now() - begin).count();
+
+    double p50 = percentile(latency, 0.50);
+    double p99 = percentile(latency, 0.99);
+
+    printf("  %-8s %6zu clients : rtt p50 %7.1f us, p99 %7.1f us, burst %9.0f messages/s",
+           name, client_count, p50, p99, client_count * BURST_ROUND / elapsed);
+
+    for (int handle : clients)
+      ::close(handle);
+  });
+
+  struct rusage usage_end;
+  getrusage(RUSAGE_SELF, &usage_end);
+
+  auto cpu_time = [](const struct rusage& usage) {
+    return usage.ru_utime.tv_sec * 1e6 + usage.ru_utime.tv_usec + usage.ru_stime.tv_sec * 1e6 + usage.ru_stime.tv_usec;
+  };
+
+  // accept, echo, 연결 해제를 모두 포함한 서버 CPU 시간
+  const size_t message_count = LATENCY_LOOP + client_count * BURST_ROUND;
+  printf(", server cpu %5.2f us/message\n", (cpu_time(usage_end) - cpu_time(usage_begin)) / message_count);
+
+  // 모든 연결이 정리될 때까지 대기
+  for (int i = 0; i < 100 && !listener.clients().empty(); ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  listener.stop();
+}
+
+inline int run_benchmark_listener()
+{
+  printf("[LISTENER] select vs epoll (loopback echo)\n");
+
+  raise_file_limit();
+
+  using backend = rs::network::stream_listener::backend;
+
+  int port = 19100;
+
+  for (size_t client_count : { 100, 1000 })
+  {
+    measure_listener(backend::select, "select", port++, client_count);
+    measure_listener(backend::epoll, "epoll", port++, client_count);
+  }
+
+  // select는 FD_SETSIZE(1024) 이상의 연결을 처리할 수 없다
+  measure_listener(backend::epoll, "epoll", port++, 10000);
+
+  // multi reactor (kernel이 SO_REUSEPORT socket으로 연결을 분배한다)
+  printf("[LISTENER] epoll reactors (%u cpus)\n", std::max(1u, std::thread::hardware_concurrency()));
+
+  for (int reactors : { 1, 2, 4 })
+  {
+    std::string name = "epoll/" + std::to_string(reactors);
+    measure_listener(backend::epoll, name.c_str(), port++, 1000, reactors);
+  }
+
+  return 0;
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <deque>
+#include <rowen/network/connector_stream.hpp>
+#include <rowen/network/connector_stream_pool.hpp>
+#include <rowen/network/listener_stream.hpp>
+
+#include "benchmark-common.hpp"
+
+// echo server (request id를 그대로 돌려준다) <-> request / response
+// - sendToRecv : 한 connection에서 요청마다 응답을 기다린다
+// - pool : connections 개의 connection에 최대 window 개의 요청을 응답을 기다리지 않고 보낸다 (pipelining)
+inline bool run_echo_listener(rs::network::stream_listener& listener, int port)
+{
+  listener.attachReceivedCallback([&](const rs::network::stream_listener::Client* client, const uint8_t* data, int size) {
+    listener.send(client, data, size);
+  });
+
+  rs::network::stream_listener::argument args;
+  args.listener_backend        = rs::network::stream_listener::backend::epoll;
+  args.listener_select_timeout = 0.1;
+  args.client_send_queue       = true;
+
+  return listener.running(port, args);
+}
+
+inline void measure_send_to_recv(int port)
+{
+  constexpr size_t REQUEST_COUNT = 20000;
+
+  rs::network::stream_listener listener;
+  if (run_echo_listener(listener, port) == false)
+    return;
+
+  rs::network::stream_connector connector;
+  if (connector.connect("127.0.0.1", port) == false)
+  {
+    printf("  %-20s : failed to connect (%s)\n", "sendToRecv", connector.error());
+    listener.stop();
+    return;
+  }
+
+  uint8_t    payload[64] = {};
+  rs::Packet packet;
+  packet.make(1, payload, sizeof(payload));
+
+  uint8_t response[256];
+
+  std::vector<double> latency;
+  latency.reserve(REQUEST_COUNT);
+
+  auto begin = bench_clock::now();
+
+  for (size_t i = 0; i < REQUEST_COUNT; ++i)
+  {
+    auto request_begin = bench_clock::now();
+
+    if (connector.sendToRecv(packet.data(), packet.size(), response, sizeof(response)) <= 0)
+      break;
+
+    latency.push_back(std::chrono::duration<double, std::micro>(bench_clock::now() - request_begin).count());
+  }
+
+  double elapsed = std::chrono::duration<double>(bench_clock::now() - begin).count();
+
+  printf("  %-20s : %9.0f requests/s, latency p50 %7.2f us, p99 %7.2f us\n",
+         "sendToRecv", latency.size() / elapsed, percentile(latency, 0.50), percentile(latency, 0.99));
+
+  connector.disconnect();
+  listener.stop();
+}
+
+inline void measure_pool(int port, int connections, size_t window)
+{
+  constexpr size_t REQUEST_COUNT = 20000;
+
+  rs::network::stream_listener listener;
+  if (run_echo_listener(listener, port) == false)
+    return;
+
+  char name[32];
+  snprintf(name, sizeof(name), "pool %d x window %zu", connections, window);
+
+  rs::network::stream_connector_pool::argument args;
+  args.connections = connections;
+
+  rs::network::stream_connector_pool pool;
+  if (pool.connect("127.0.0.1", port, args) == false)
+  {
+    printf("  %-20s : failed to connect (%s)\n", name, pool.error());
+    listener.stop();
+    return;
+  }
+
+  uint8_t    payload[64] = {};
+  rs::Packet packet;
+  packet.make(1, payload, sizeof(payload));
+
+  using Request = std::pair<bench_clock::time_point, rs::network::stream_connector_pool::Response>;
+
+  std::deque<Request> requests;
+  std::vector<double> latency;
+  latency.reserve(REQUEST_COUNT);
+
+  size_t failed = 0;
+
+  auto complete = [&]() {
+    try
+    {
+      requests.front().second.get();
+      latency.push_back(std::chrono::duration<double, std::micro>(bench_clock::now() - requests.front().first).count());
+    }
+    catch (const std::exception&)
+    {
+      failed++;
+    }
+    requests.pop_front();
+  };
+
+  auto begin = bench_clock::now();
+
+  for (size_t i = 0; i < REQUEST_COUNT; ++i)
+  {
+    if (requests.size() >= window)
+      complete();
+
+    auto request_begin = bench_clock::now();
+    requests.emplace_back(request_begin, pool.request(packet));
+  }
+
+  while (requests.empty() == false)
+    complete();
+
+  double elapsed = std::chrono::duration<double>(bench_clock::now() - begin).count();
+
+  printf("  %-20s : %9.0f requests/s, latency p50 %7.2f us, p99 %7.2f us (failed %zu)\n",
+         name, latency.size() / elapsed, percentile(latency, 0.50), percentile(latency, 0.99), failed);
+
+  pool.disconnect();
+  listener.stop();
+}
+
+inline int run_benchmark_pool()
+{
+  int port = 19600;
+
+  printf("[POOL] request / response (64 bytes payload)\n");
+
+  measure_send_to_recv(port++);
+  measure_pool(port++, 1, 1);
+  measure_pool(port++, 1, 64);
+  measure_pool(port++, 4, 64);
+
+  return 0;
+}
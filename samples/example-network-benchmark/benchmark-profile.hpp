@@ -0,0 +1,94 @@
+#pragma once
+
+#include <rowen/network/connector_stream.hpp>
+#include <rowen/network/listener_stream.hpp>
+
+#include "benchmark-common.hpp"
+
+// 제어 메시지 요청 / 응답 (header, body를 나누어 send() 두 번, 서버는 요청 전체를 받은 뒤 응답)
+// - default : Nagle이 두 번째 send()를 첫 번째 send()의 ack까지 붙잡고, 수신 측은 delayed ack으로 응답이 늦어진다
+// - latency : TCP_NODELAY, TCP_QUICKACK, TCP_USER_TIMEOUT
+inline void measure_profile(const rs::network::TcpProfile& profile, int port)
+{
+  constexpr size_t REQUEST_COUNT = 100;
+  constexpr size_t HEADER_SIZE   = 16;
+  constexpr size_t BODY_SIZE     = 48;
+
+  rs::network::stream_listener listener;
+
+  // 요청 전체 (header + body)를 받은 뒤 한 번에 응답한다
+  std::vector<uint8_t> request;
+
+  listener.attachReceivedCallback([&](const rs::network::stream_listener::Client* client, const uint8_t* data, int size) {
+    request.insert(request.end(), data, data + size);
+
+    if (request.size() >= HEADER_SIZE + BODY_SIZE)
+    {
+      listener.send(client, request.data(), HEADER_SIZE + BODY_SIZE);
+      request.erase(request.begin(), request.begin() + HEADER_SIZE + BODY_SIZE);
+    }
+  });
+
+  rs::network::stream_listener::argument listener_args;
+  listener_args.listener_backend        = rs::network::stream_listener::backend::epoll;
+  listener_args.listener_select_timeout = 0.1;
+  listener_args.client_tcp_profile      = profile;
+
+  if (listener.running(port, listener_args) == false)
+  {
+    printf("  %-10s : failed to run listener (%s)\n", profile.name, listener.error());
+    return;
+  }
+
+  rs::network::stream_connector connector;
+
+  rs::network::stream_connector::argument connector_args;
+  connector_args.tcp_profile = profile;
+
+  if (connector.connect("127.0.0.1", port, connector_args) == false)
+  {
+    printf("  %-10s : failed to connect (%s)\n", profile.name, connector.error());
+    listener.stop();
+    return;
+  }
+
+  uint8_t header[HEADER_SIZE] = {};
+  uint8_t body[BODY_SIZE]     = {};
+  uint8_t response[HEADER_SIZE + BODY_SIZE];
+
+  std::vector<double> latency;
+  latency.reserve(REQUEST_COUNT);
+
+  for (size_t i = 0; i < REQUEST_COUNT; ++i)
+  {
+    auto request_begin = bench_clock::now();
+
+    if (connector.send(header, sizeof(header)) <= 0 || connector.send(body, sizeof(body)) <= 0 ||
+        recv_all(connector.socket().id(), response, sizeof(response)) == false)
+      break;
+
+    latency.push_back(std::chrono::duration<double, std::micro>(bench_clock::now() - request_begin).count());
+  }
+
+  const auto effective = connector.socket().tcpProfile();
+
+  printf("  %-10s : latency p50 %8.1f us, p99 %8.1f us (effective : nodelay %d, quickack %d, sndbuf %d, rcvbuf %d, busy_poll %d, user_timeout %d)\n",
+         profile.name, percentile(latency, 0.50), percentile(latency, 0.99),
+         effective.no_delay, effective.quick_ack, effective.send_buffer, effective.recv_buffer, effective.busy_poll, effective.user_timeout);
+
+  connector.disconnect();
+  listener.stop();
+}
+
+inline int run_benchmark_profile()
+{
+  int port = 19870;
+
+  printf("[PROFILE] request / response with split send (header 16 bytes + body 48 bytes)\n");
+
+  measure_profile(rs::network::TcpProfile(), port++);
+  measure_profile(rs::network::TcpProfile::latency(), port++);
+  measure_profile(rs::network::TcpProfile::throughput(), port++);
+
+  return 0;
+}
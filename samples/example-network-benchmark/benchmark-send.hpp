@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <rowen/network/connector_stream.hpp>
+#include <rowen/network/listener_stream.hpp>
+#include <thread>
+
+#include "benchmark-common.hpp"
+
+// connector -> listener (sink) 1 MiB frame 전송
+// - send_buffer_size : Socket::send()가 나누어 전송하는 크기 (0 : 한 번에 전송)
+inline void measure_send_chunk(int send_buffer_size, int port)
+{
+  constexpr size_t FRAME_SIZE  = 1 << 20;
+  constexpr size_t FRAME_COUNT = 256;
+
+  std::atomic<size_t> received_size = { 0 };
+
+  rs::network::stream_listener listener;
+
+  listener.attachReceivedCallback([&](const rs::network::stream_listener::Client*, const uint8_t*, int size) {
+    received_size.fetch_add(size, std::memory_order_relaxed);
+  });
+
+  rs::network::stream_listener::argument listener_args;
+  listener_args.listener_backend        = rs::network::stream_listener::backend::epoll;
+  listener_args.listener_select_timeout = 0.1;
+  listener_args.listener_buffer_size    = 1 << 18;
+
+  if (listener.running(port, listener_args) == false)
+  {
+    printf("  chunk %5d : failed to run listener (%s)\n", send_buffer_size, listener.error());
+    return;
+  }
+
+  rs::network::stream_connector connector;
+
+  rs::network::stream_connector::argument connector_args;
+  connector_args.send_buffer_size = send_buffer_size;
+
+  if (connector.connect("127.0.0.1", port, connector_args) == false)
+  {
+    printf("  chunk %5d : failed to connect (%s)\n", send_buffer_size, connector.error());
+    listener.stop();
+    return;
+  }
+
+  std::vector<uint8_t> frame(FRAME_SIZE, 0xA5);
+
+  struct rusage usage_begin;
+  getrusage(RUSAGE_THREAD, &usage_begin);
+
+  auto begin = bench_clock::now();
+
+  for (size_t i = 0; i < FRAME_COUNT; ++i)
+    connector.send(frame.data(), frame.size());
+
+  struct rusage usage_end;
+  getrusage(RUSAGE_THREAD, &usage_end);
+
+  for (int i = 0; i < 500 && received_size.load() < FRAME_SIZE * FRAME_COUNT; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  double elapsed = std::chrono::duration<double>(bench_clock::now() - begin).count();
+
+  auto cpu_time = [](const struct rusage& usage) {
+    return usage.ru_utime.tv_sec * 1e6 + usage.ru_utime.tv_usec + usage.ru_stime.tv_sec * 1e6 + usage.ru_stime.tv_usec;
+  };
+
+  printf("  chunk %5d : %8.1f MiB/s, sender cpu %7.1f us/frame\n",
+         send_buffer_size, FRAME_COUNT / elapsed,
+         (cpu_time(usage_end) - cpu_time(usage_begin)) / FRAME_COUNT);
+
+  connector.disconnect();
+  listener.stop();
+}
+
+inline int run_benchmark_send()
+{
+  printf("[SEND] 1 MiB frame (Socket::send chunking)\n");
+
+  int port = 19400;
+
+  // 1024 : 이전 기본값 (1 MiB frame = 1024 send syscall)
+  for (int send_buffer_size : { 1024, 65536, 0 })
+    measure_send_chunk(send_buffer_size, port++);
+
+  return 0;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <rowen/core/transport/packet_gather.hpp>
+#include <rowen/network/connector_stream.hpp>
+#include <rowen/network/listener_stream.hpp>
+#include <thread>
+
+#include "benchmark-common.hpp"
+#include "benchmark-listener.hpp"
+
+// connector -> listener (sink) 단방향 전송
+// - gather packet (header, payload, trailer)을 전송한다 (io_uring : linked SEND chain)
+// - latency : send() 호출 시간, throughput : listener가 모두 수신할 때까지의 처리량
+inline void measure_connector(rs::network::stream_connector::backend backend, const char* name, int port, size_t payload_size)
+{
+  constexpr size_t MESSAGE_COUNT = 100000;
+
+  std::atomic<size_t> received_size = { 0 };
+
+  rs::network::stream_listener listener;
+
+  listener.attachReceivedCallback([&](const rs::network::stream_listener::Client*, const uint8_t*, int size) {
+    received_size.fetch_add(size, std::memory_order_relaxed);
+  });
+
+  rs::network::stream_listener::argument listener_args;
+  listener_args.listener_backend        = rs::network::stream_listener::backend::epoll;
+  listener_args.listener_select_timeout = 0.1;
+  listener_args.listener_buffer_size    = 65536;
+
+  if (listener.running(port, listener_args) == false)
+  {
+    printf("  %-8s : failed to run listener (%s)\n", name, listener.error());
+    return;
+  }
+
+  rs::network::stream_connector connector;
+
+  rs::network::stream_connector::argument connector_args;
+  connector_args.connector_backend = backend;
+  connector_args.send_buffer_size  = 65536;
+
+  if (connector.connect("127.0.0.1", port, connector_args) == false)
+  {
+    printf("  %-8s : failed to connect (%s)\n", name, connector.error());
+    listener.stop();
+    return;
+  }
+
+  std::vector<uint8_t> payload(payload_size, 0x5A);
+  rs::PacketGather     packet(1, payload.data(), payload.size());
+
+  std::vector<double> latency;
+  latency.reserve(MESSAGE_COUNT);
+
+  auto begin = bench_clock::now();
+
+  for (size_t i = 0; i < MESSAGE_COUNT; ++i)
+  {
+    auto send_begin = bench_clock::now();
+
+    if (connector.send(packet) != packet.size())
+    {
+      printf("  %-8s : send failed (%s)\n", name, connector.error());
+      break;
+    }
+
+    latency.push_back(std::chrono::duration<double, std::micro>(bench_clock::now() - send_begin).count());
+  }
+
+  const size_t expected_size = latency.size() * packet.size();
+  for (int i = 0; i < 500 && received_size.load() < expected_size; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  double elapsed = std::chrono::duration<double>(bench_clock::now() - begin).count();
+
+  printf("  %-8s payload %5zu : %9.0f messages/s, send p50 %6.2f us, p99 %6.2f us (io_uring : %s)\n",
+         name, payload_size, latency.size() / elapsed,
+         percentile(latency, 0.50), percentile(latency, 0.99), connector.using_io_uring() ? "yes" : "no");
+
+  connector.disconnect();
+  listener.stop();
+}
+
+inline int run_benchmark_uring()
+{
+  using listener_backend  = rs::network::stream_listener::backend;
+  using connector_backend = rs::network::stream_connector::backend;
+
+  printf("[URING] io_uring supported : %s\n", rs::network::Uring::supported() ? "yes" : "no (fallback to epoll/socket)");
+
+  raise_file_limit();
+
+  int port = 19300;
+
+  // listener : epoll vs io_uring (multishot accept/recv, provided buffer ring)
+  printf("[URING] listener epoll vs io_uring (loopback echo)\n");
+
+  for (size_t client_count : { 100, 1000 })
+  {
+    measure_listener(listener_backend::epoll, "epoll", port++, client_count);
+    measure_listener(listener_backend::io_uring, "io_uring", port++, client_count);
+  }
+
+  // connector : socket (sendmsg) vs io_uring (linked SEND chain)
+  printf("[URING] connector socket vs io_uring (gather packet)\n");
+
+  for (size_t payload_size : { 64, 4096 })
+  {
+    measure_connector(connector_backend::socket, "socket", port++, payload_size);
+    measure_connector(connector_backend::io_uring, "io_uring", port++, payload_size);
+  }
+
+  return 0;
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include <rowen/network/detail/socket.hpp>
+#include <vector>
+
+#include "benchmark-common.hpp"
+
+// process CPU time (user + system, seconds)
+inline double process_cpu_time()
+{
+  struct rusage usage = {};
+  getrusage(RUSAGE_SELF, &usage);
+
+  return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+// loopback 수신 프로세스 (연결 하나를 끝까지 수신한다)
+inline pid_t run_sink_process(int& port)
+{
+  int handle = ::socket(AF_INET, SOCK_STREAM, 0);
+
+  sockaddr_in address     = {};
+  address.sin_family      = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  socklen_t address_size = sizeof(address);
+
+  if (handle < 0 ||
+      ::bind(handle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1 ||
+      ::listen(handle, 1) == -1 ||
+      ::getsockname(handle, reinterpret_cast<sockaddr*>(&address), &address_size) == -1)
+  {
+    if (handle >= 0)
+      ::close(handle);
+    return -1;
+  }
+
+  port = ntohs(address.sin_port);
+
+  fflush(stdout);
+
+  pid_t pid = fork();
+  if (pid == 0)
+  {
+    int client = ::accept(handle, nullptr, nullptr);
+
+    std::vector<uint8_t> buffer(1 << 20);
+    while (client >= 0 && ::recv(client, buffer.data(), buffer.size(), 0) > 0)
+      ;
+
+    _exit(0);
+  }
+
+  ::close(handle);
+  return pid;
+}
+
+// rs::network::Socket -> 수신 프로세스 (loopback)
+// - copy : send() (kernel socket 버퍼로 복사)
+// - zerocopy : sendZeroCopy() (MSG_ZEROCOPY. 완료 통지를 받을 때까지 frame 버퍼를 재사용하지 않는다)
+// - cpu : 전송 프로세스의 CPU 시간 (수신 프로세스 제외)
+inline void measure_zerocopy(const char* name, bool zerocopy, size_t frame_size)
+{
+  constexpr size_t TOTAL_SIZE  = size_t(1) << 30;
+  constexpr size_t FRAME_COUNT = 8;  // frame 버퍼 수
+
+  int   port = 0;
+  pid_t sink = run_sink_process(port);
+  if (sink < 0)
+  {
+    printf("  %-9s : failed to run sink\n", name);
+    return;
+  }
+
+  rs::network::Socket socket;
+
+  if (socket.open(SOCK_STREAM) == false || socket.connect("127.0.0.1", port) == false)
+  {
+    printf("  %-9s : failed to connect (%s)\n", name, socket.cerror());
+    socket.close();
+    waitpid(sink, nullptr, 0);
+    return;
+  }
+
+  socket.setSendFlags(MSG_NOSIGNAL);
+
+  if (zerocopy && socket.setZeroCopy(true) == false)
+  {
+    printf("  %-9s : zero copy is not supported (%s)\n", name, socket.cerror());
+    socket.close();
+    waitpid(sink, nullptr, 0);
+    return;
+  }
+
+  std::vector<std::vector<uint8_t>> frames(FRAME_COUNT, std::vector<uint8_t>(frame_size, 0x5A));
+  std::vector<bool>                 in_flight(FRAME_COUNT, false);
+
+  const size_t send_count = TOTAL_SIZE / frame_size;
+  size_t       sent_size  = 0;
+
+  auto   begin     = bench_clock::now();
+  double cpu_begin = process_cpu_time();
+
+  for (size_t i = 0; i < send_count; ++i)
+  {
+    const size_t index = i % FRAME_COUNT;
+
+    // 이전 전송이 끝나지 않은 frame 버퍼는 완료 통지를 기다린다
+    while (in_flight[index])
+      if (socket.completeZeroCopy(0.01) < 0)
+        break;
+
+    in_flight[index] = zerocopy;
+
+    ssize_t res = socket.sendZeroCopy(frames[index].data(), frame_size, [&, index](bool) { in_flight[index] = false; });
+    if (res != static_cast<ssize_t>(frame_size))
+    {
+      printf("  %-9s : send failed (%s)\n", name, socket.cerror());
+      break;
+    }
+
+    sent_size += res;
+  }
+
+  while (socket.zeroCopyPending() > 0)
+    if (socket.completeZeroCopy(0.01) < 0)
+      break;
+
+  double cpu     = process_cpu_time() - cpu_begin;
+  double elapsed = std::chrono::duration<double>(bench_clock::now() - begin).count();
+  double gib     = sent_size / double(size_t(1) << 30);
+
+  const uint64_t copied = socket.zeroCopyCopied();
+
+  printf("  %-9s frame %5zu KiB : %6.2f GiB/s, sender cpu %7.1f ms/GiB, copied by kernel %llu / %zu\n",
+         name, frame_size / 1024, gib / elapsed, cpu * 1000 / gib,
+         static_cast<unsigned long long>(copied), zerocopy ? send_count : 0);
+
+  socket.close();
+  waitpid(sink, nullptr, 0);
+}
+
+inline int run_benchmark_zerocopy()
+{
+  printf("[ZEROCOPY] Socket send vs sendZeroCopy (loopback, 1 GiB)\n");
+
+  for (size_t frame_size : { 64 * 1024, 4 * 1024 * 1024 })
+  {
+    measure_zerocopy("copy", false, frame_size);
+    measure_zerocopy("zerocopy", true, frame_size);
+  }
+
+  return 0;
+}
@@ -0,0 +1,27 @@
+#include "benchmark-allocation.hpp"
+#include "benchmark-backpressure.hpp"
+#include "benchmark-broadcast.hpp"
+#include "benchmark-config.hpp"
+#include "benchmark-dgram.hpp"
+#include "benchmark-listener.hpp"
+#include "benchmark-pool.hpp"
+#include "benchmark-profile.hpp"
+#include "benchmark-send.hpp"
+#include "benchmark-uring.hpp"
+#include "benchmark-zerocopy.hpp"
+
+int main()
+{
+  run_benchmark_listener();
+  run_benchmark_uring();
+  run_benchmark_send();
+  run_benchmark_dgram();
+  run_benchmark_pool();
+  run_benchmark_allocation();
+  run_benchmark_backpressure();
+  run_benchmark_broadcast();
+  run_benchmark_zerocopy();
+  run_benchmark_profile();
+  run_benchmark_config();
+  return 0;
+}
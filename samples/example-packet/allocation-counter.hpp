@@ -0,0 +1,28 @@
+#pragma once
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// 전역 operator new를 교체하여 할당 횟수를 센다 (샘플 실행 파일에서만 사용)
+inline std::atomic<size_t> allocation_count = 0;
+
+void* operator new(size_t size)
+{
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+  if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    return ptr;
+
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+  std::free(ptr);
+}
@@ -0,0 +1,59 @@
+#include <chrono>
+#include <iostream>
+#include <rowen/core/packet.hpp>
+
+#include "allocation-counter.hpp"
+
+inline int run_benchmark_builder()
+{
+  constexpr int PACKET_COUNT = 100000;
+
+  uint8_t telemetry[256] = {};
+  for (size_t i = 0; i < sizeof(telemetry); ++i)
+    telemetry[i] = static_cast<uint8_t>(i);
+
+  std::cout << "[PacketBuilder] " << PACKET_COUNT << " packets (payload " << sizeof(telemetry) << " bytes)" << std::endl;
+
+  auto measure = [&](const char* name, auto&& make_packet) {
+    make_packet();  // warm up (pool buffer)
+
+    size_t allocation = allocation_count.load();
+    auto   begin      = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < PACKET_COUNT; ++i)
+      make_packet();
+
+    auto   end     = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(end - begin).count();
+
+    printf("    %-14s : %9.3f ms, %10.0f packets/s, %7zu allocations\n",
+           name, elapsed * 1000, PACKET_COUNT / elapsed, allocation_count.load() - allocation);
+  };
+
+  measure("Packet::make", [&] {
+    rs::Packet packet;
+    packet.make(1, telemetry, sizeof(telemetry));
+  });
+
+  measure("builder(pool)", [&] {
+    rs::PacketBuilder builder;
+    builder.make(1, telemetry, sizeof(telemetry));
+  });
+
+  uint8_t buffer[rs::Packet::PACKET_SIZE(sizeof(telemetry))];
+  measure("builder(span)", [&] {
+    rs::PacketBuilder builder(buffer, sizeof(buffer));
+    builder.make(1, telemetry, sizeof(telemetry));
+  });
+
+  measure("builder(write)", [&] {
+    rs::PacketBuilder builder;
+    if (auto payload = builder.prepare(1, sizeof(telemetry)))
+    {
+      std::memcpy(payload, telemetry, sizeof(telemetry));
+      builder.commit();
+    }
+  });
+
+  return 0;
+}
@@ -0,0 +1,101 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <rowen/core/packet.hpp>
+#include <rowen_3rd/jsoncpp.hpp>
+
+// telemetry JSON (객체 배열)
+inline std::string make_telemetry_json(size_t record_count, bool styled)
+{
+  std::mt19937                          engine(7);
+  std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+
+  Json::Value root;
+  root["device"]  = "rowen-sensor-01";
+  root["version"] = "1.4.2";
+
+  for (size_t i = 0; i < record_count; ++i)
+  {
+    Json::Value record;
+    record["sequence"]  = static_cast<Json::UInt>(i);
+    record["timestamp"] = static_cast<Json::UInt64>(1717200000000000ULL + i * 1000);
+    record["state"]     = i % 7 == 0 ? "warning" : "normal";
+    record["position"]["x"] = position(engine);
+    record["position"]["y"] = position(engine);
+    record["position"]["z"] = position(engine);
+    record["battery"]       = 87;
+    root["records"].append(record);
+  }
+
+  Json::StreamWriterBuilder builder;
+  if (!styled)
+    builder["indentation"] = "";
+
+  return Json::writeString(builder, root);
+}
+
+inline int run_benchmark_compress()
+{
+  std::cout << "[COMPRESS] LZ payload compression (FLAG_COMPRESSED)" << std::endl;
+
+  constexpr size_t TOTAL_BYTES = 64 * 1024 * 1024;  // bytes per case
+
+  for (bool styled : { false, true })
+  {
+    for (size_t record_count : { 4, 64, 1024 })
+    {
+      auto         json    = make_telemetry_json(record_count, styled);
+      auto         payload = reinterpret_cast<const uint8_t*>(json.data());
+      const size_t size    = json.size();
+      const size_t repeat  = std::max<size_t>(1, TOTAL_BYTES / size);
+
+      std::vector<uint8_t> compressed(rs::lz_compress_bound(size));
+      std::vector<uint8_t> decompressed(size);
+
+      // compress
+      size_t compressed_size = 0;
+      auto   begin           = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < repeat; ++i)
+        compressed_size = rs::lz_compress(payload, size, compressed.data(), compressed.size());
+      double compress_elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+      // decompress
+      ssize_t decompressed_size = 0;
+      begin                     = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < repeat; ++i)
+        decompressed_size = rs::lz_decompress(compressed.data(), compressed_size, decompressed.data(), decompressed.size());
+      double decompress_elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+      bool matched = decompressed_size == static_cast<ssize_t>(size) && std::memcmp(decompressed.data(), payload, size) == 0;
+
+      // PacketReceiver (압축 해제 포함)
+      rs::PacketBuilder builder;
+      builder.makeCompressed(1, payload, size);
+
+      std::vector<uint8_t> stream;
+      const size_t         packet_count = std::min<size_t>(repeat, 4096);
+      for (size_t i = 0; i < packet_count; ++i)
+        stream.insert(stream.end(), builder.data(), builder.data() + builder.size());
+
+      rs::PacketReceiver        receiver;
+      rs::PacketReceiver::Spans packets;
+      size_t                    received = 0;
+
+      begin = std::chrono::steady_clock::now();
+      for (size_t offset = 0; offset < stream.size(); offset += 64 * 1024)
+      {
+        receiver.store_and_drain(stream.data() + offset, std::min<size_t>(64 * 1024, stream.size() - offset), packets);
+        for (auto& packet : packets)
+          received += packet.size == static_cast<size_t>(rs::Packet::PACKET_SIZE(size)) ? 1 : 0;
+      }
+      double receive_elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+      printf("  %s json %8zu bytes : ratio %5.2f, compress %7.1f MB/s, decompress %7.1f MB/s, receiver %7.1f MB/s (%s, packets %zu / %zu)\n",
+             styled ? "styled" : "compact", size, static_cast<double>(size) / compressed_size,
+             size * repeat / compress_elapsed / 1e6, size * repeat / decompress_elapsed / 1e6,
+             size * packet_count / receive_elapsed / 1e6, matched ? "ok" : "mismatch", received, packet_count);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,32 @@
+#include <chrono>
+#include <iostream>
+#include <rowen/core/packet.hpp>
+
+inline int run_benchmark_crc()
+{
+  std::cout << "[CRC32C] implementation : " << rs::crc32c_implementation() << std::endl;
+
+  std::vector<uint8_t> buffer(4 * 1024 * 1024);
+  for (size_t i = 0; i < buffer.size(); ++i)
+    buffer[i] = static_cast<uint8_t>(i * 31 + 7);
+
+  constexpr size_t TOTAL_BYTES = 256 * 1024 * 1024;  // bytes per payload size
+
+  for (size_t payload_size = 64; payload_size <= buffer.size(); payload_size *= 4)
+  {
+    const size_t iteration = std::max<size_t>(1, TOTAL_BYTES / payload_size);
+
+    volatile uint32_t crc   = 0;
+    auto              begin = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < iteration; ++i)
+      crc = rs::crc32c(buffer.data(), payload_size, crc);
+
+    auto   end     = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(end - begin).count();
+
+    printf("  payload %8zu bytes : %7.2f GB/s\n", payload_size, (payload_size * iteration) / elapsed / 1e9);
+  }
+
+  return 0;
+}
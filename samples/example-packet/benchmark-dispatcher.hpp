@@ -0,0 +1,92 @@
+#include <chrono>
+#include <iostream>
+#include <rowen/core/packet.hpp>
+
+struct DispatchCounter
+{
+  uint64_t total = 0;
+
+  void onSparse(const rs::Packet::Header&, const rs::PacketSpan& payload) { total += payload.size; }
+};
+
+inline int run_benchmark_dispatcher()
+{
+  std::cout << "[DISPATCHER] callback(switch) vs dispatcher" << std::endl;
+
+  constexpr size_t   PACKET_COUNT  = 1000000;
+  constexpr size_t   CHUNK_SIZE    = 64 * 1024;
+  constexpr uint32_t OPCODES[]     = { 1, 2, 3, 4, 100, 200, 0x10000, 0x20000 };
+  constexpr size_t   OPCODE_COUNT  = sizeof(OPCODES) / sizeof(OPCODES[0]);
+  constexpr size_t   PAYLOAD_SIZE  = 32;
+
+  // stream
+  std::vector<uint8_t> stream;
+  {
+    uint8_t payload[PAYLOAD_SIZE] = {};
+    uint8_t buffer[rs::Packet::PACKET_SIZE(PAYLOAD_SIZE)];
+
+    for (size_t i = 0; i < PACKET_COUNT; ++i)
+    {
+      rs::PacketBuilder builder(buffer, sizeof(buffer));
+      builder.make(OPCODES[i % OPCODE_COUNT], payload, sizeof(payload));
+      stream.insert(stream.end(), builder.data(), builder.data() + builder.size());
+    }
+  }
+
+  auto feed = [&](rs::PacketReceiver& receiver) {
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t offset = 0; offset < stream.size(); offset += CHUNK_SIZE)
+      receiver.store(stream.data() + offset, std::min(CHUNK_SIZE, stream.size() - offset));
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  };
+
+  auto report = [](const char* name, double elapsed, uint64_t total) {
+    printf("  %-10s : %9.3f ms, %10.0f packets/s (payload %lu bytes)\n", name, elapsed * 1000, PACKET_COUNT / elapsed, total);
+  };
+
+  // std::function + switch
+  {
+    uint64_t           total = 0;
+    rs::PacketReceiver receiver;
+
+    receiver.attachCallback([&](const uint8_t* data, const ssize_t) {
+      auto header = reinterpret_cast<const rs::Packet::Header*>(data);
+      switch (header->data.opcode)
+      {
+        case 1: case 2: case 3: case 4: case 100: case 200:
+          total += header->data.payload_size;
+          break;
+        case 0x10000: case 0x20000:
+          total += header->data.payload_size;
+          break;
+        default:
+          break;
+      }
+    });
+
+    double elapsed = feed(receiver);
+    report("callback", elapsed, total);
+  }
+
+  // dispatcher
+  {
+    DispatchCounter      counter;
+    rs::PacketDispatcher dispatcher;
+    rs::PacketReceiver   receiver;
+
+    for (size_t i = 0; i < 6; ++i)
+      dispatcher.on(OPCODES[i], [&](const rs::Packet::Header&, const rs::PacketSpan& payload) { counter.total += payload.size; });
+    dispatcher.on<&DispatchCounter::onSparse>(0x10000, &counter);
+    dispatcher.on<&DispatchCounter::onSparse>(0x20000, &counter);
+
+    receiver.attachDispatcher(&dispatcher);
+
+    double elapsed = feed(receiver);
+    report("dispatcher", elapsed, counter.total);
+
+    for (auto& statistics : dispatcher.statistics())
+      printf("    opcode %#8x : count %8lu, bytes %10lu, last timestamp %lu\n", statistics.opcode, statistics.count, statistics.bytes, statistics.last_timestamp);
+  }
+
+  return 0;
+}
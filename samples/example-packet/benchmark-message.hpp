@@ -0,0 +1,88 @@
+#include <chrono>
+#include <iostream>
+#include <rowen/core/packet.hpp>
+#include <rowen_3rd/jsoncpp.hpp>
+
+struct Telemetry
+{
+  uint32_t sequence;
+  float    position[3];
+  float    velocity[3];
+  uint8_t  state;
+};
+
+struct Command
+{
+  uint32_t sequence;
+  int32_t  action;
+};
+
+using TelemetryRegistry = rs::message_registry<rs::message<0x100, Telemetry>, rs::message<0x200, Command>>;
+
+inline int run_benchmark_message()
+{
+  std::cout << "[MESSAGE] typed message vs json (encode + decode)" << std::endl;
+
+  constexpr size_t PACKET_COUNT = 100000;
+
+  auto report = [](const char* name, double elapsed, size_t received) {
+    printf("  %-8s : %9.3f ms, %10.0f messages/s (received %zu)\n", name, elapsed * 1000, PACKET_COUNT / elapsed, received);
+  };
+
+  // JSON : Json::Value -> string -> Packet -> parse
+  {
+    Json::StreamWriterBuilder                writer_builder;
+    Json::CharReaderBuilder                  reader_builder;
+    std::unique_ptr<Json::CharReader>        reader(reader_builder.newCharReader());
+    writer_builder["indentation"] = "";
+
+    size_t received = 0;
+    auto   begin    = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < PACKET_COUNT; ++i)
+    {
+      Json::Value root;
+      root["sequence"] = static_cast<Json::UInt>(i);
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        root["position"].append(1.0f * axis);
+        root["velocity"].append(0.5f * axis);
+      }
+      root["state"] = 1;
+
+      rs::Packet packet(0x100, Json::writeString(writer_builder, root));
+
+      Json::Value parsed;
+      auto        text = reinterpret_cast<const char*>(packet.payload());
+      if (reader->parse(text, text + packet.payload_size(), &parsed, nullptr) && parsed["sequence"].asUInt() == i)
+        received++;
+    }
+
+    report("json", std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count(), received);
+  }
+
+  // typed : struct -> packet (stack) -> jump table -> handler
+  {
+    TelemetryRegistry registry;
+    size_t            received = 0;
+
+    registry.on<Telemetry>([&](const Telemetry& telemetry) { received += telemetry.state; });
+
+    auto begin = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < PACKET_COUNT; ++i)
+    {
+      Telemetry telemetry = { static_cast<uint32_t>(i), { 0, 1, 2 }, { 0, 0.5f, 1 }, 1 };
+
+      uint8_t           buffer[TelemetryRegistry::message_of<Telemetry>::packet_size];
+      rs::PacketBuilder builder(buffer, sizeof(buffer));
+      TelemetryRegistry::encode(builder, telemetry);
+
+      registry.dispatch(builder.span());
+    }
+
+    report("typed", std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count(), received);
+  }
+
+  return 0;
+}
@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <rowen/core/packet.hpp>
+
+// PacketReceiver 이전 구현 (매 패킷마다 std::vector 앞부분을 erase)
+class LegacyPacketReceiver
+{
+ public:
+  void attachCallback(const std::function<void(const uint8_t*, const ssize_t)>& callback) { callback_ = callback; }
+
+  void store(const uint8_t* buffer, const ssize_t size)
+  {
+    cache_.insert(cache_.end(), buffer, buffer + size);
+
+    while (true)
+    {
+      if (found_ == false)
+      {
+        auto iter = cache_.begin();
+
+        do
+        {
+          iter = std::find(iter, cache_.end(), rs::Packet::SOH);
+
+          if (iter == cache_.end() || iter + rs::Packet::HEADER_SIZE > cache_.end())
+            break;
+
+          auto candidate = reinterpret_cast<rs::Packet::Header*>(&(*iter));
+          if (candidate->STX_ != rs::Packet::STX ||
+              candidate->data.total_size != rs::Packet::PACKET_SIZE(candidate->data.payload_size))
+          {
+            iter++;
+            continue;
+          }
+
+          cache_.erase(cache_.begin(), iter);
+          found_ = true;
+          break;
+        } while (iter < cache_.end());
+      }
+
+      if (found_ == false)
+        break;
+
+      // (이전 구현은 Header 포인터를 보관하여 insert 이후 dangling 될 수 있었다. 비교를 위해 매번 다시 얻는다)
+      auto total_size = reinterpret_cast<rs::Packet::Header*>(cache_.data())->data.total_size;
+      if (cache_.size() < total_size)
+        break;
+
+      callback_(cache_.data(), total_size);
+
+      cache_.erase(cache_.begin(), cache_.begin() + total_size);
+      found_ = false;
+
+      usleep(1);
+    }
+  }
+
+ private:
+  std::vector<uint8_t>                               cache_;
+  bool                                               found_ = false;
+  std::function<void(const uint8_t*, const ssize_t)> callback_;
+};
+
+template <typename Receiver>
+inline double measure_receiver(const std::vector<uint8_t>& stream, size_t recv_size, int batch_count, size_t& received)
+{
+  Receiver receiver;
+  receiver.attachCallback([&](const uint8_t*, const ssize_t) { received++; });
+
+  auto begin = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < batch_count; ++i)
+  {
+    // 한 번의 recv()로 여러 패킷이 들어온 상황 (recv_size 단위로 전달)
+    for (size_t offset = 0; offset < stream.size(); offset += recv_size)
+      receiver.store(stream.data() + offset, std::min(recv_size, stream.size() - offset));
+  }
+
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(end - begin).count();
+}
+
+inline double measure_receiver_drain(const std::vector<uint8_t>& stream, size_t recv_size, int batch_count, size_t& received)
+{
+  rs::PacketReceiver        receiver;
+  rs::PacketReceiver::Spans packets;
+
+  auto begin = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < batch_count; ++i)
+  {
+    for (size_t offset = 0; offset < stream.size(); offset += recv_size)
+      received += receiver.store_and_drain(stream.data() + offset, std::min(recv_size, stream.size() - offset), packets);
+  }
+
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(end - begin).count();
+}
+
+inline double measure_receiver_grab(const std::vector<uint8_t>& stream, size_t recv_size, int batch_count, size_t& received)
+{
+  rs::PacketReceiver         receiver;
+  rs::PacketReceiver::Result packets;
+
+  auto begin = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < batch_count; ++i)
+  {
+    for (size_t offset = 0; offset < stream.size(); offset += recv_size)
+    {
+      receiver.store(stream.data() + offset, std::min(recv_size, stream.size() - offset));
+      received += receiver.grab(packets);
+    }
+  }
+
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(end - begin).count();
+}
+
+inline int run_benchmark_receiver()
+{
+  constexpr int PACKET_COUNT = 10000;  // packets per batch
+  constexpr int BATCH_COUNT  = 3;
+
+  // 10k small packets (JSON payload)
+  std::vector<uint8_t> stream;
+  rs::Packet           packet(1, R"({"id":1,"temperature":36.5,"state":"ok"})");
+
+  for (int i = 0; i < PACKET_COUNT; ++i)
+    stream.insert(stream.end(), packet.data(), packet.data() + packet.size());
+
+  std::cout << "[PacketReceiver] " << PACKET_COUNT << " packets x " << BATCH_COUNT << " batches ("
+            << stream.size() << " bytes per batch)" << std::endl;
+
+  auto print = [&](const char* name, double elapsed, size_t received) {
+    printf("    %-8s : %8zu packets, %9.3f ms, %12.0f packets/s\n", name, received, elapsed * 1000, received / elapsed);
+  };
+
+  for (size_t recv_size : { size_t(64 * 1024), stream.size() })
+  {
+    std::cout << "  recv size : " << recv_size << " bytes" << std::endl;
+
+    size_t legacy_received = 0;
+    auto   legacy_elapsed  = measure_receiver<LegacyPacketReceiver>(stream, recv_size, BATCH_COUNT, legacy_received);
+    print("legacy", legacy_elapsed, legacy_received);
+
+    size_t current_received = 0;
+    auto   current_elapsed  = measure_receiver<rs::PacketReceiver>(stream, recv_size, BATCH_COUNT, current_received);
+    print("current", current_elapsed, current_received);
+
+    size_t drain_received = 0;
+    auto   drain_elapsed  = measure_receiver_drain(stream, recv_size, BATCH_COUNT, drain_received);
+    print("drain", drain_elapsed, drain_received);
+
+    size_t grab_received = 0;
+    auto   grab_elapsed  = measure_receiver_grab(stream, recv_size, BATCH_COUNT, grab_received);
+    print("grab", grab_elapsed, grab_received);
+  }
+
+  return 0;
+}
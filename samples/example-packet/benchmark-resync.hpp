@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <rowen/core/packet.hpp>
+
+// 기존 std::find 기반 header 탐색 (비교용)
+inline const uint8_t* find_packet_header_legacy(const uint8_t* first, const uint8_t* last)
+{
+  for (auto iter = first; iter < last; ++iter)
+  {
+    iter = std::find(iter, last, rs::Packet::SOH);
+
+    if (iter == last || last - iter < rs::Packet::HEADER_SIZE)
+      return iter;
+
+    auto header = reinterpret_cast<const rs::Packet::Header*>(iter);
+    if (header->STX_ == rs::Packet::STX && header->data.total_size == rs::Packet::PACKET_SIZE(header->data.payload_size))
+      return iter;
+  }
+
+  return last;
+}
+
+// random garbage 사이에 packet을 섞는다 (soh_ratio : SOH/STX 바이트 비율, 0이면 uniform random)
+inline std::vector<uint8_t> make_garbage_stream(size_t size, size_t packet_interval, int soh_ratio, size_t& packet_count)
+{
+  std::mt19937                       engine(20240601);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::uniform_int_distribution<int> percent(0, 99);
+
+  std::vector<uint8_t> payload(256, 0xAB);
+  rs::Packet           packet;
+  packet.make(1, payload.data(), payload.size());
+
+  std::vector<uint8_t> stream;
+  stream.reserve(size + size / packet_interval * packet.size());
+
+  packet_count = 0;
+
+  while (stream.size() < size)
+  {
+    for (size_t i = 0; i < packet_interval; ++i)
+    {
+      if (soh_ratio > 0 && percent(engine) < soh_ratio)
+        stream.push_back(percent(engine) % 2 ? rs::Packet::SOH : rs::Packet::STX);
+      else
+        stream.push_back(static_cast<uint8_t>(byte(engine)));
+    }
+
+    stream.insert(stream.end(), packet.data(), packet.data() + packet.size());
+    packet_count++;
+  }
+
+  return stream;
+}
+
+template <typename Finder>
+inline size_t count_headers(const std::vector<uint8_t>& stream, Finder finder)
+{
+  size_t count = 0;
+  auto   first = stream.data();
+  auto   last  = stream.data() + stream.size();
+
+  while (true)
+  {
+    first = finder(first, last);
+    if (last - first < rs::Packet::HEADER_SIZE)
+      break;
+
+    count++;
+    first++;
+  }
+
+  return count;
+}
+
+inline int run_benchmark_resync()
+{
+  std::cout << "[RESYNC] implementation : " << rs::packet_scanner_implementation() << std::endl;
+
+  constexpr size_t STREAM_SIZE = 64 * 1024 * 1024;
+  constexpr size_t CHUNK_SIZE  = 64 * 1024;
+
+  for (int soh_ratio : { 0, 5, 50 })
+  {
+    size_t packet_count = 0;
+    auto   stream       = make_garbage_stream(STREAM_SIZE, 1024 * 1024, soh_ratio, packet_count);
+
+    auto measure = [&](const char* name, auto finder) {
+      auto   begin   = std::chrono::steady_clock::now();
+      size_t found   = count_headers(stream, finder);
+      auto   end     = std::chrono::steady_clock::now();
+      double elapsed = std::chrono::duration<double>(end - begin).count();
+
+      printf("  soh/stx %2d%% %-8s : %7.2f GB/s (headers %zu / %zu)\n", soh_ratio, name, stream.size() / elapsed / 1e9, found, packet_count);
+    };
+
+    measure("legacy", find_packet_header_legacy);
+    measure("scanner", rs::find_packet_header);
+
+    // PacketReceiver (chunk 단위 수신)
+    rs::PacketReceiver        receiver;
+    rs::PacketReceiver::Spans packets;
+
+    size_t received = 0;
+    auto   begin    = std::chrono::steady_clock::now();
+
+    for (size_t offset = 0; offset < stream.size(); offset += CHUNK_SIZE)
+      received += receiver.store_and_drain(stream.data() + offset, std::min(CHUNK_SIZE, stream.size() - offset), packets);
+
+    auto   end     = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(end - begin).count();
+
+    printf("  soh/stx %2d%% %-8s : %7.2f GB/s (packets %zu / %zu)\n", soh_ratio, "receiver", stream.size() / elapsed / 1e9, received, packet_count);
+  }
+
+  return 0;
+}
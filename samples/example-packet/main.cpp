@@ -0,0 +1,19 @@
+#include "benchmark-builder.hpp"
+#include "benchmark-compress.hpp"
+#include "benchmark-crc.hpp"
+#include "benchmark-dispatcher.hpp"
+#include "benchmark-message.hpp"
+#include "benchmark-receiver.hpp"
+#include "benchmark-resync.hpp"
+
+int main()
+{
+  run_benchmark_receiver();
+  run_benchmark_crc();
+  run_benchmark_builder();
+  run_benchmark_resync();
+  run_benchmark_message();
+  run_benchmark_dispatcher();
+  run_benchmark_compress();
+  return 0;
+}